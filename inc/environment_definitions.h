@@ -71,6 +71,19 @@ struct WorkingSetElement {
 
 //2020
 LIST_HEAD(WS_List, WorkingSetElement);		// Declares 'struct WS_list'
+
+//2026: compact WS entry, used instead of the WS list when the WS is kept in an array
+struct WSArrayEntry {
+	uint32 va_sweeps;		// page VA (bits 31:12) | sweeps counter (bits 11:1) | valid (bit 0)
+	uint32 time_stamp;
+};
+#define WSA_VALID			0x1
+#define WSA_MAX_SWEEPS		0x7FF
+#define WSA_IS_VALID(entry)	((entry)->va_sweeps & WSA_VALID)
+#define WSA_VA(entry)		((entry)->va_sweeps & ~0xFFF)
+#define WSA_SWEEPS(entry)	(((entry)->va_sweeps & 0xFFF) >> 1)
+#define WSA_SET(entry, va, sweeps) \
+	((entry)->va_sweeps = ((va) & ~0xFFF) | ((((sweeps) > WSA_MAX_SWEEPS) ? WSA_MAX_SWEEPS : (sweeps)) << 1) | WSA_VALID)
 //======================================================================
 
 //2024 (ref: xv6 OS - x86 version)
@@ -95,6 +108,31 @@ struct Context {
   uint32 eip;
 };
 
+//2026: scheduler accounting states & latency histogram
+#define SCHED_ACCT_NONE		0
+#define SCHED_ACCT_READY	1
+#define SCHED_ACCT_RUNNING	2
+#define SCHED_ACCT_BLOCKED	3
+#define SCHED_HIST_BUCKETS	16
+
+//2026: a kernel timer (see kern/cpu/ktimer.h)
+LIST_HEAD(ktimer_list, ktimer);
+struct ktimer
+{
+	uint32 expires;					// tick at which it expires
+	void (*fn)(struct ktimer *);	// called from the clock interrupt when it expires
+	void *arg;
+	struct ktimer_list *list;		// the wheel slot it's linked in (NULL if not pending)
+	LIST_ENTRY(ktimer) prev_next_info;
+};
+
+//2026: IPC states of a receiver (see kern/conc/ipc.h)
+#define IPC_IDLE		0	// not receiving
+#define IPC_RECVING		1	// blocked in sys_ipc_recv, waiting for a sender
+#define IPC_BUSY		2	// a sender is delivering its message
+#define IPC_DELIVERED	3	// got the message, not yet returned to user
+#define IPC_DEAD		4	// freed: its blocked senders give up
+
 struct Env {
 	//================
 	/*MAIN INFO...*/
@@ -141,6 +179,8 @@ struct Env {
 #if USE_KHEAP
 	struct WS_List page_WS_list ;					//List of WS elements
 	struct WorkingSetElement* page_last_WS_element;	//ptr to last inserted WS element
+	struct WSArrayEntry* page_WS_array;				//2026: if not NULL, the WS is kept here (page_WS_max_size entries) instead of page_WS_list
+	uint32 page_WS_array_size;						//2026: # valid entries in page_WS_array (its clock hand is page_last_WS_index)
 #else
 	struct WorkingSetElement ptr_pageWorkingSet[__PWS_MAX_SIZE];
 	//uint32 page_last_WS_index;
@@ -167,6 +207,18 @@ struct Env {
 	//==================
 	/*CPU BSD Sched...*/
 	//==================
+	int nice;						// [-20, 20]: the higher the nice, the lower the priority
+	fixed_point_t recent_cpu;		// decayed # ticks it has run recently
+	uint32 bsd_second;				// 2026: last second whose recent_cpu decay was applied to it
+	uint8 bsd_dirty;				// 2026: it ran since the last priority recomputation
+
+	//=====================
+	/*CPU Stride Sched...*/
+	//=====================
+	uint32 tickets;					// 2026: its share of the CPU relative to the other envs
+	uint32 stride;					// 2026: STRIDE1 / tickets
+	uint32 pass;					// 2026: virtual time: the ready env with the min pass runs next
+	int32 heap_index;				// 2026: its index in the stride min-heap (-1 if not in it)
 
 	//================
 	/*STATISTICS...*/
@@ -181,6 +233,16 @@ struct Env {
 	//2020
 	uint32 nPageIn, nPageOut, nNewPageAdded;
 	uint32 nClocks ;
+	//2026: scheduler accounting (in TSC cycles)
+	uint8 sched_state;					// SCHED_ACCT_xxx: the state its time is currently accounted to
+	uint64 sched_state_since;			// TSC when it entered this state
+	uint64 sched_ready_time;			// cumulative wait in the ready queues
+	uint64 sched_max_ready_wait;		// longest single wait in the ready queues
+	uint64 sched_run_time;
+	uint64 sched_blocked_time;
+	uint32 nvcsw;						// voluntary switches (blocked/exited)
+	uint32 nivcsw;						// involuntary switches (preempted)
+	uint32 sched_wait_hist[SCHED_HIST_BUCKETS];	// ready waits: bucket i counts the ones < 2^(i+11) cycles (>= 2^(i+10) if i > 0)
 
 	// For user heap block allocator
 	uint32 uheap_start;
@@ -188,7 +250,30 @@ struct Env {
 	uint32 uheap_limit;
 
 	// For priority promotion in priority scheduler MS3
-	uint32 age;
+	uint32 age;						// ticks it waited in the ready queues (priority >= 1) since its last promotion, till ready_since
+	uint32 ready_since;				// 2026: tick at which it's linked in its current ready queue
+	// 2026: index of the ready queue it's linked in (valid while it's READY)
+	uint8 ready_queue;
+	uint32 mlfq_epoch;				// 2026: MLFQ: value of mlfq_boost_epoch as of its last level update
+	// 2026: lock-free wakeups
+	struct Env *wake_next;			// link in the list of woken up envs to be made ready
+	void *blocked_chan;				// the channel it sleeps on (NULL for a user semaphore)
+	// 2026: futex it waits on: (shared object, offset of the word inside it)
+	int32 futex_share;
+	uint32 futex_offset;
+	// 2026: timeout of its channel sleep (see sleep_timeout())
+	struct ktimer sleep_timer;
+	uint8 sleep_timed_out;
+	// 2026: message passing (see sys_ipc_send/recv): the last received message
+	uint8 ipc_state;				// IPC_xxx
+	uint32 ipc_dstva;				// where to map the received pages
+	uint32 ipc_maxpages;			// max # pages to receive there
+	int32 ipc_from;					// its sender
+	uint32 ipc_value;				// its word (passed in registers)
+	uint32 ipc_npages;				// # pages moved to ipc_dstva
+	struct ipc_page *ipc_pages;		// the pages on their way to it (kernel)
+	// 2026: the shared objects it created (kernel, see shared_memory_manager)
+	struct Share *shares;
 };
 
 #define PRIORITY_LOW    		1
@@ -28,6 +28,8 @@
 
 #define E_NO_TABLE -21					// Table not exists for the given VA
 
+#define E_FUTEX_AGAIN -22				// 2026: the futex word doesn't hold the expected value (no wait)
+
 #define	MAXERROR	100
 
 #endif	// !FOS_INC_ERROR_H */
@@ -0,0 +1,33 @@
+// 2026: user-level mutexes & condition variables on top of the kernel futexes
+#ifndef FOS_INC_FUTEX_H
+#define FOS_INC_FUTEX_H
+
+#include <inc/types.h>
+
+//# tries of a contended lock before blocking in the kernel
+#define FUTEX_SPIN_COUNT 100
+
+//They MUST be placed in shared memory (smalloc/sget) & zero initialized:
+//the kernel identifies a futex by (shared object, offset inside it).
+//Both take NO system call when uncontended.
+struct umutex
+{
+	uint32 state;		//0: unlocked, 1: locked, 2: locked & (maybe) has waiters
+};
+struct ucond
+{
+	uint32 seq;			//incremented by each signal/broadcast
+	uint32 waiters;		//# envs waiting (no wakeup syscall if 0)
+};
+
+void umutex_init(struct umutex *m);
+void umutex_lock(struct umutex *m);
+int umutex_trylock(struct umutex *m);
+void umutex_unlock(struct umutex *m);
+
+void ucond_init(struct ucond *cv);
+void ucond_wait(struct ucond *cv, struct umutex *m);
+void ucond_signal(struct ucond *cv);
+void ucond_broadcast(struct ucond *cv);
+
+#endif /*FOS_INC_FUTEX_H*/
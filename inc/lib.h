@@ -16,6 +16,8 @@
 #include <inc/x86.h>
 #include <inc/environment_definitions.h>
 #include <inc/semaphore.h>
+#include <inc/futex.h>
+#include <inc/ring.h>
 #include <inc/memlayout.h>
 #include <inc/syscall.h>
 #include <inc/uheap.h>
@@ -53,6 +55,8 @@ void 	sys_exit_env();
 int 	sys_create_env(char* programName, unsigned int page_WS_size,unsigned int LRU_second_list_size,unsigned int percent_WS_pages_to_remove);
 int		sys_destroy_env(int32 envId);
 void	sys_run_env(int32 envId);
+int		sys_env_fork(void);
+int		sys_env_set_tickets(int32 envID, uint32 tickets);
 
 //Memory
 int 	__sys_allocate_page(void *va, int perm);
@@ -73,7 +77,7 @@ void* 	sys_sbrk(int increment);
 void 	sys_free_user_mem(uint32 virtual_address, uint32 size);
 void	sys_allocate_user_mem(uint32 virtual_address, uint32 size);
 void	sys_allocate_chunk(uint32 virtual_address, uint32 size, uint32 perms);
-void 	sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size);
+int 	sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size);
 uint32 	sys_isUHeapPlacementStrategyFIRSTFIT();
 uint32 	sys_isUHeapPlacementStrategyBESTFIT();
 uint32 	sys_isUHeapPlacementStrategyNEXTFIT();
@@ -86,6 +90,14 @@ int 	sys_pf_calculate_allocated_pages(void);
 //Semaphores
 void    block_and_schedule_next(struct __semdata *semdata);
 void     unblock_and_enqueue_ready(struct __semdata *semdata);
+int 	sys_futex_wait(uint32 *uaddr, uint32 val);	//2026
+int 	sys_futex_wake(uint32 *uaddr, int count);	//2026
+
+//Message passing (2026)
+int 	sys_ipc_send(int32 envID, uint32 value, void *srcva, uint32 npages);
+int 	sys_ipc_recv(void *dstva, uint32 maxpages);
+int 	ipc_send(int32 envID, uint32 value, void *srcva, uint32 npages);
+uint32 	ipc_recv(int32 *from_env, void *dstva, uint32 maxpages, uint32 *npages);
 
 
 //Sharing
@@ -114,6 +126,8 @@ void 	sys_utilities(char* utilityName, int value);
 
 /* concurrency.c */
 void env_sleep(uint32 apprxMilliSeconds);
+void env_sleep_busy(uint32 apprxMilliSeconds);	//2026
+void sys_sleep_ms(uint32 milliseconds);		//2026
 uint32 busy_wait(uint32 loopMax);
 #define CYCLES_PER_MILLISEC 10000
 
@@ -224,6 +224,22 @@ struct FrameInfo {
 
 	// Working set element this frame is mapped to
 	struct WorkingSetElement *wse;
+	//2026: page directory of the env owning wse (a frame shared by fork is
+	// mapped in several envs: wse is valid for its owner only)
+	uint32 *wse_dir;
+	//2026: if the WS of that env is kept as an array: index of its entry there
+	uint32 ws_index;
+
+	// If this frame holds a user page table: # of its entries that are
+	// present or marked (see PTE_IS_LIVE). Makes the emptiness check O(1).
+	uint16 live_ptes;
+
+	//2026: If this frame was allocated for a shared object: isShared is set
+	// till the frame is freed, shareID & sharePage locate it in the object
+	// till the object is deleted (shareID = 0 after that)
+	unsigned char isShared;
+	int32 shareID;
+	uint32 sharePage;
 };
 
 #endif /* !__ASSEMBLER__ */
@@ -67,6 +67,7 @@
 #define PTE_PS		0x080	// Page Size
 #define PTE_MBZ		0x180	// Bits must be zero
 #define PERM_BUFFERED 0x200 //Page it buffered
+#define PERM_COW 0x400 // Copy-on-write page shared with a forked env (mapped read-only)
 #define PERM_USER_MARKED 0x800 // Mark page as lazy allocated
 
 // The PERM_AVAILABLE bits aren't used by the kernel or interpreted by the
@@ -0,0 +1,58 @@
+// 2026: lock-free ring buffers for messaging between environments
+#ifndef FOS_INC_RING_H
+#define FOS_INC_RING_H
+
+#include <inc/types.h>
+
+//Ring types
+#define RING_SPSC	0		//single producer, single consumer
+#define RING_MPMC	1		//multiple producers, multiple consumers
+
+//To keep the producer & consumer indices in separate cache lines
+#define RING_CACHELINE	64
+
+//Header of a ring created in a shared object (ring_create/ring_open). The
+//message slots follow it.
+//Sending & receiving are lock-free & take NO system call, unless the ring is
+//full (send) or empty (recv): the caller then sleeps on a futex till the
+//other side makes progress.
+//SPSC: the producer only writes tail & the consumer only writes head.
+//MPMC: bounded queue of D. Vyukov: each slot has a sequence # that tells
+//      whether it's ready to be written or read at a given position. Envs
+//      claim a position by a CAS on tail/head.
+struct ring
+{
+	//set once by ring_create
+	uint32 type;
+	uint32 size;			//# slots (power of 2)
+	uint32 mask;			//size - 1
+	uint32 elem_size;		//message size (in bytes)
+	uint32 slot_size;		//slot size (+ sequence # in MPMC)
+
+	//producer side: next position to write
+	volatile uint32 tail __attribute__((aligned(RING_CACHELINE)));
+	uint32 send_blocks;		//# times a producer slept on a full ring
+
+	//consumer side: next position to read
+	volatile uint32 head __attribute__((aligned(RING_CACHELINE)));
+	uint32 recv_blocks;		//# times a consumer slept on an empty ring
+
+	//futexes: bumped only when someone is waiting on them
+	uint32 not_empty __attribute__((aligned(RING_CACHELINE)));
+	uint32 empty_waiters;
+	uint32 not_full;
+	uint32 full_waiters;
+
+	uint8 slots[] __attribute__((aligned(RING_CACHELINE)));
+};
+
+struct ring* ring_create(char *name, uint32 nslots, uint32 elem_size, int type);
+struct ring* ring_open(int32 ownerEnvID, char *name);
+
+int ring_trysend(struct ring *r, const void *msg);
+int ring_tryrecv(struct ring *r, void *msg);
+void ring_send(struct ring *r, const void *msg);
+void ring_recv(struct ring *r, void *msg);
+uint32 ring_count(struct ring *r);
+
+#endif /*FOS_INC_RING_H*/
@@ -9,12 +9,16 @@ struct __semdata
 	//queue of all blocked envs on this Semaphore
 	struct Env_Queue queue;
 
-	//semaphore value
+	//semaphore value (-ve: # waiters)
 	int count;
 
 	//lock variable protecting this count
+	//2026: not used by wait/signal (they update the count atomically)
 	uint32 lock;
 
+	//2026: # signals not yet consumed by the waiters (futex they sleep on)
+	uint32 wakeups;
+
 	// For debugging: Name of semaphore.
 	char name[64];
 };
@@ -57,6 +57,13 @@ enum
 	//=====================================================================
 	SYS_PROCESS_BLOCKED_SCHED,
 	SYS_UNBLOCK_AND_ENQUEUE_READY,
+	SYS_env_fork,
+	SYS_env_set_tickets,
+	SYS_futex_wait,
+	SYS_futex_wake,
+	SYS_sleep_ms,
+	SYS_ipc_send,
+	SYS_ipc_recv,
 	NSYSCALLS
 };
 
@@ -30,6 +30,9 @@ static __inline void lcr2(uint32 val) __attribute__((always_inline));
 static __inline void cli() __attribute__((always_inline));
 static __inline void sti() __attribute__((always_inline));
 static __inline uint32 xchg(volatile uint32 *addr, uint32 newval) __attribute__((always_inline));
+static __inline uint32 cmpxchg(volatile uint32 *addr, uint32 expected, uint32 newval) __attribute__((always_inline));
+static __inline uint32 xadd(volatile uint32 *addr, uint32 val) __attribute__((always_inline));
+static __inline void cpu_relax(void) __attribute__((always_inline));
 static __inline void lgdt(struct Segdesc *p, int size) __attribute__((always_inline));
 static __inline void lidt(struct Gatedesc *p, int size) __attribute__((always_inline));
 //****************
@@ -48,6 +51,7 @@ static __inline void write_esp(uint32 esp) __attribute__((always_inline));
 static __inline void write_ebp(uint32 ebp) __attribute__((always_inline));
 static __inline void cpuid(uint32 info, uint32 *eaxp, uint32 *ebxp, uint32 *ecxp, uint32 *edxp);
 static __inline uint64 read_tsc(void) __attribute__((always_inline));
+static __inline uint32 bit_scan_forward(uint32 word) __attribute__((always_inline));
 
 static __inline void
 breakpoint(void)
@@ -310,6 +314,15 @@ read_tsc(void)
         return tsc;
 }
 
+//Index of the least significant set bit (word must NOT be 0)
+static __inline uint32
+bit_scan_forward(uint32 word)
+{
+	uint32 index;
+	__asm __volatile("bsfl %1,%0" : "=r" (index) : "rm" (word));
+	return index;
+}
+
 /*2024: newly added functions from xv6-x86 code el7 :)
  * https://github.com/mit-pdos/xv6-public
  */
@@ -342,6 +355,39 @@ xchg(volatile uint32 *addr, uint32 newval)
   return result;
 }
 
+//2026: atomic compare & exchange: set *addr to newval if it equals expected
+//Returns the old value of *addr (i.e. it succeeded if it returns expected)
+static __inline uint32
+cmpxchg(volatile uint32 *addr, uint32 expected, uint32 newval)
+{
+  uint32 prev;
+  __asm __volatile("lock; cmpxchgl %2, %1" :
+               "=a" (prev), "+m" (*addr) :
+               "r" (newval), "0" (expected) :
+               "cc", "memory");
+  return prev;
+}
+
+//2026: atomic fetch & add: add val to *addr
+//Returns the old value of *addr
+static __inline uint32
+xadd(volatile uint32 *addr, uint32 val)
+{
+  __asm __volatile("lock; xaddl %0, %1" :
+               "+r" (val), "+m" (*addr) :
+               :
+               "cc", "memory");
+  return val;
+}
+
+//2026: spin-wait hint (PAUSE): saves power & avoids the memory order
+//violation penalty when leaving a spin loop
+static __inline void
+cpu_relax(void)
+{
+	__asm __volatile("pause" ::: "memory");
+}
+
 //load GDT register
 static __inline void
 lgdt(struct Segdesc *p, int size)
@@ -19,6 +19,10 @@
 #include "../tests/tst_handler.h"
 #include "../tests/utilities.h"
 #include "../cons/console.h"
+#include "../cpu/kclock.h"
+#include "../cpu/ktimer.h"
+#include "../conc/channel.h"
+#include "../conc/lockstat.h"
 
 //Array of commands. (initialized)
 struct Command commands[] =
@@ -53,6 +57,15 @@ struct Command commands[] =
 		{"nomodbuff", "disable modified buffer", command_disable_modified_buffer, 0},
 		{"modbuff", "enable modified buffer", command_enable_modified_buffer, 0},
 		{"modbufflength?", "get modified buffer length", command_get_modified_buffer_length, 0},
+		{"wsarray", "keep the WS of the new envs in a compact array", command_enable_ws_array, 0},
+		{"wslist", "keep the WS of the new envs in a list (default)", command_disable_ws_array, 0},
+		{"tickless", "stretch the quantum of a lone env & halt the CPU when idle", command_enable_tickless, 0},
+		{"notickless", "interrupt the running env every quantum & spin when idle (default)", command_disable_tickless, 0},
+		{"tickstat", "display the clock ticks, the ones saved by the tickless mode & the kernel timers", command_tickstat, 0},
+		{"blocked", "list the blocked environments by channel", command_print_blocked, 0},
+		{"schedstat", "display the ready/run/blocked times & ready-wait histograms per environment & per ready queue", command_schedstat, 0},
+		{"lockstat", "list the hottest locks (spin, sleep, semaphores) by contention", command_lockstat, 0},
+		{"lockstatreset", "reset the lock contention statistics", command_lockstat_reset, 0},
 
 		//*****************************//
 		/* COMMANDS WITH ONE ARGUMENT */
@@ -65,13 +78,14 @@ struct Command commands[] =
 
 		{"modbufflength", "set the length of the modified buffer", command_set_modified_buffer_length, 1},
 		{ "setStarvThr", "set the the starvation threshold of priority scheduler", command_set_starve_thresh, 1},
+		{ "schedSTRIDE", "switch the scheduler to STRIDE (proportional share) with given quantum", command_sch_STRIDE, 1},
 
 		//******************************//
 		/* COMMANDS WITH TWO ARGUMENTS */
 		//******************************//
 		{ "wm", "writes one byte to specific physical location" ,command_writemem_k, 2},
 		{ "schedBSD", "switch the scheduler to BSD with given # queues & quantum", command_sch_BSD, 2},
-		{ "setPri", "set the priority of the given environment (by its ID)", command_set_priority, 2},
+		{ "setPri", "set the priority (or the tickets under STRIDE) of the given environment (by its ID)", command_set_priority, 2},
 		{"nclock", "set replacement algorithm to Nth chance CLOCK (type=1: NORMAL Ver. type=2: MODIFIED Ver.", command_set_page_rep_nthCLOCK, 2},
 
 		//********************************//
@@ -359,6 +373,10 @@ int command_meminfo(int number_of_arguments, char **arguments)
 
 	cprintf("Num of calls for kheap_virtual_address [in last run] = %d\n", numOfKheapVACalls);
 
+	cprintf("Pre-zeroed frames = %d (zeroed when idle = %d)\nZeroed allocations: from pool = %d, zeroed in place = %d\n",
+			LIST_SIZE(&MemFrameLists.zeroed_frame_list), zeroed_frames_counters.zeroedWhenIdle,
+			zeroed_frames_counters.hits, zeroed_frames_counters.misses);
+
 	return 0;
 }
 
@@ -652,11 +670,28 @@ int command_set_starve_thresh(int number_of_arguments, char **arguments)
 	sched_set_starv_thresh(starvationThresh);
 	return 0;
 }
+int command_sch_STRIDE(int number_of_arguments, char **arguments)
+{
+	uint8 quantum = strtol(arguments[1], NULL, 10);
+
+	sched_init_STRIDE(quantum);
+
+	cprintf("Scheduler is now set to STRIDE with quantum = %d\n", quantum);
+	cprintf("\n");
+	return 0;
+}
 int command_set_priority(int number_of_arguments, char **arguments)
 {
 	int32 envId = strtol(arguments[1],NULL, 10);
 	int32 priority = strtol(arguments[2],NULL, 10);
 
+	//STRIDE: the given value is the # tickets of the env
+	if (isSchedMethodSTRIDE())
+	{
+		if (env_set_tickets(envId, priority) < 0)
+			cprintf("invalid env id %d\n", envId);
+		return 0;
+	}
 	env_set_priority(envId, priority);
 
 	return 0;
@@ -693,6 +728,10 @@ int command_print_sch_method(int number_of_arguments, char **arguments)
 	{
 		cprintf("Scheduler is now set to PRIORITY RR with %d priorities & quantum = %d\n", num_of_ready_queues, quantums[0]);
 	}
+	else if (isSchedMethodSTRIDE())
+	{
+		cprintf("Current scheduler method is STRIDE with quantum %d ms\n", quantums[0]);
+	}
 	else
 		cprintf("Current scheduler method is UNDEFINED\n");
 
@@ -895,6 +934,70 @@ int command_enable_buffering(int number_of_arguments, char **arguments)
 	return 0;
 }
 
+/*2026 ============================================================================*/
+
+int command_enable_ws_array(int number_of_arguments, char **arguments)
+{
+	enableWSArray(1);
+	cprintf("WS of the new envs will be kept in a compact ARRAY\n");
+	return 0;
+}
+
+int command_disable_ws_array(int number_of_arguments, char **arguments)
+{
+	enableWSArray(0);
+	cprintf("WS of the new envs will be kept in a LIST\n");
+	return 0;
+}
+
+int command_enable_tickless(int number_of_arguments, char **arguments)
+{
+	kclock_tickless = 1;
+	cprintf("Tickless mode is ENABLED\n");
+	return 0;
+}
+
+int command_disable_tickless(int number_of_arguments, char **arguments)
+{
+	kclock_tickless = 0;
+	cprintf("Tickless mode is DISABLED\n");
+	return 0;
+}
+
+int command_tickstat(int number_of_arguments, char **arguments)
+{
+	cprintf("Tickless mode = %s\n", kclock_tickless ? "ON" : "OFF");
+	cprintf("Ticks = %d\n", (uint32)ticks);
+	cprintf("Saved ticks (stretched quanta) = %d\n", tickless_counters.saved_ticks);
+	cprintf("Idle halts = %d, Idle cycles = %llu\n", tickless_counters.idle_halts, tickless_counters.idle_cycles);
+	cprintf("Timers: pending = %d, expired = %d\n", ktimer_wheel.pending, ktimer_wheel.fired);
+	return 0;
+}
+
+int command_print_blocked(int number_of_arguments, char **arguments)
+{
+	print_blocked_channels();
+	return 0;
+}
+
+int command_schedstat(int number_of_arguments, char **arguments)
+{
+	sched_print_stats();
+	return 0;
+}
+
+int command_lockstat(int number_of_arguments, char **arguments)
+{
+	lockstat_print(20);
+	return 0;
+}
+
+int command_lockstat_reset(int number_of_arguments, char **arguments)
+{
+	lockstat_reset();
+	return 0;
+}
+
 int command_set_modified_buffer_length(int number_of_arguments, char **arguments)
 {
 	if(!isBufferingEnabled())
@@ -83,6 +83,17 @@ int command_enable_modified_buffer(int number_of_arguments, char **arguments);
 int command_disable_buffering(int number_of_arguments, char **arguments);
 int command_enable_buffering(int number_of_arguments, char **arguments);
 
+//2026
+int command_enable_ws_array(int number_of_arguments, char **arguments);
+int command_disable_ws_array(int number_of_arguments, char **arguments);
+int command_enable_tickless(int number_of_arguments, char **arguments);
+int command_disable_tickless(int number_of_arguments, char **arguments);
+int command_tickstat(int number_of_arguments, char **arguments);
+int command_print_blocked(int number_of_arguments, char **arguments);
+int command_schedstat(int number_of_arguments, char **arguments);
+int command_lockstat(int number_of_arguments, char **arguments);
+int command_lockstat_reset(int number_of_arguments, char **arguments);
+
 int command_set_modified_buffer_length(int number_of_arguments, char **arguments);
 int command_get_modified_buffer_length(int number_of_arguments, char **arguments);
 
@@ -97,6 +108,7 @@ int command_sch_test(int number_of_arguments, char **arguments);
 int command_tst(int number_of_arguments, char **arguments);
 
 //2024
+int command_sch_STRIDE(int number_of_arguments, char **arguments);
 int command_set_priority(int number_of_arguments, char **arguments);
 int command_set_starve_thresh(int number_of_arguments, char **arguments);
 int command_sched_init_PRIRR(int number_of_arguments, char **arguments);
@@ -7,6 +7,7 @@
 #include "channel.h"
 #include <kern/proc/user_environment.h>
 #include <kern/cpu/sched.h>
+#include <kern/cpu/ktimer.h>
 #include <inc/string.h>
 #include <inc/disk.h>
 
@@ -18,6 +19,42 @@ void init_channel(struct Channel *chan, char *name)
 {
 	strcpy(chan->name, name);
 	init_queue(&(chan->queue));
+	init_spinlock(&(chan->qlk), "channel queue lock");
+	chan->prev_blocked = chan->next_blocked = NULL;
+}
+
+//2026: blocked accounting: the list of channels having blocked processes & the
+//total # blocked processes, so that the scheduler knows whether any process is
+//blocked in O(1). Both are protected by the qlock: a channel is linked by
+//sleep() and unlinked when its last process is moved to the ready queues.
+static int chan_is_linked(struct Channel *chan)
+{
+	return chan->prev_blocked != NULL || blocked_channels == chan;
+}
+static void chan_link_blocked(struct Channel *chan)
+{
+	if (chan_is_linked(chan))
+		return;
+	chan->prev_blocked = NULL;
+	chan->next_blocked = blocked_channels;
+	if (blocked_channels != NULL)
+		blocked_channels->prev_blocked = chan;
+	blocked_channels = chan;
+}
+void chan_unlink_if_empty(struct Channel *chan)
+{
+	acquire_spinlock(&chan->qlk);
+	int empty = (queue_size(&chan->queue) == 0);
+	release_spinlock(&chan->qlk);
+	if (!empty || !chan_is_linked(chan))
+		return;
+	if (chan->prev_blocked != NULL)
+		chan->prev_blocked->next_blocked = chan->next_blocked;
+	else
+		blocked_channels = chan->next_blocked;
+	if (chan->next_blocked != NULL)
+		chan->next_blocked->prev_blocked = chan->prev_blocked;
+	chan->prev_blocked = chan->next_blocked = NULL;
 }
 
 //===============================
@@ -29,17 +66,26 @@ void init_channel(struct Channel *chan, char *name)
 void sleep(struct Channel *chan, struct spinlock *lk)
 {
 	//TODO: [PROJECT'24.MS1 - #10] [4] LOCKS - sleep
+	struct Env *current_running_process = get_cpu_proc();
 
-	// To be able to release the sleep lock guard without missing wake-up
+	// A wakeup doesn't need the qlock (the queue has its own lock), but the
+	// woken up process is made ready only when the scheduler drains the
+	// wakeups under the qlock. So take it BEFORE the process is on the queue,
+	// and hold it till it's switched out: it can't run twice, and it's
+	// counted as blocked before a drain can uncount it.
 	acquire_spinlock(&ProcessQueues.qlock);
-
-	// Release the given sleep lock guard before being blocked
-	release_spinlock(lk);
+	ProcessQueues.num_blocked++;
+	chan_link_blocked(chan);
 
 	// Enqueue the current process into the given waiting queue and block it
-	struct Env *current_running_process = get_cpu_proc();
-	enqueue(&chan->queue, current_running_process);
+	acquire_spinlock(&chan->qlk);
 	current_running_process->env_status = ENV_BLOCKED;
+	current_running_process->blocked_chan = chan;
+	enqueue(&chan->queue, current_running_process);
+	release_spinlock(&chan->qlk);
+
+	// Release the given sleep lock guard before being blocked
+	release_spinlock(lk);
 
 	// Let the scheduler go back to scheduling ready processes
 	sched();
@@ -55,52 +101,146 @@ void sleep(struct Channel *chan, struct spinlock *lk)
 	acquire_spinlock(lk);
 }
 
+//2026: the timeout of a sleep_timeout(): wake it up if still on the channel
+static void sleep_timeout_expired(struct ktimer *t)
+{
+	struct Env *env = (struct Env *)t->arg;
+	struct Channel *chan = (struct Channel *)env->blocked_chan;
+	if (chan == NULL)
+		return;
+	int found = 0;
+	acquire_spinlock(&chan->qlk);
+	if (find_env_in_queue(&chan->queue, env->env_id) == env)
+	{
+		remove_from_queue(&chan->queue, env);
+		found = 1;
+	}
+	release_spinlock(&chan->qlk);
+	if (found)
+	{
+		env->sleep_timed_out = 1;
+		sched_wakeup_lockfree(env);
+	}
+}
+
+//2026: sleep on chan for at most the given # clock ticks
+//Returns 1 if the timeout elapsed before a wakeup, 0 otherwise
+int sleep_timeout(struct Channel *chan, struct spinlock *lk, uint32 timeout_ticks)
+{
+	struct Env *current_running_process = get_cpu_proc();
+	current_running_process->sleep_timed_out = 0;
+	//lk is held: it can't expire before we're on the channel
+	ktimer_add(&current_running_process->sleep_timer, timeout_ticks, sleep_timeout_expired, current_running_process);
+	sleep(chan, lk);
+	ktimer_cancel(&current_running_process->sleep_timer);
+	return current_running_process->sleep_timed_out;
+}
+
 //==================================================
 // 3) WAKEUP ONE BLOCKED PROCESS ON A GIVEN CHANNEL:
 //==================================================
 // Wake up ONE process sleeping on chan.
-// The qlock must be held.
 // Ref: xv6-x86 OS code
 // chan MUST be of type "struct Env_Queue" to hold the blocked processes
-void wakeup_one(struct Channel *chan)
+// 2026: doesn't take the qlock: the process is pushed to the lock-free list
+// of wakeups that the scheduler moves to the ready queues
+// 2026: returns the woken up process (NULL if none)
+struct Env* wakeup_one(struct Channel *chan)
 {
 	//TODO: [PROJECT'24.MS1 - #11] [4] LOCKS - wakeup_one
+	struct Env *process_to_wakeup = NULL;
 
-	// To not continue if there is a process currently going to sleep
-	acquire_spinlock(&ProcessQueues.qlock);
-
-	struct Env_Queue *blocked_queue = &chan->queue;
-
-	if (queue_size(blocked_queue) > 0) {
-		struct Env *process_to_wakeup = dequeue(blocked_queue);
-		sched_insert_ready(process_to_wakeup);
+	acquire_spinlock(&chan->qlk);
+	if (queue_size(&chan->queue) > 0) {
+		process_to_wakeup = dequeue(&chan->queue);
 	}
+	release_spinlock(&chan->qlk);
 
-	// To re-enable other processes to sleep
-	release_spinlock(&ProcessQueues.qlock);
+	if (process_to_wakeup != NULL)
+		sched_wakeup_lockfree(process_to_wakeup);
+	return process_to_wakeup;
 }
 
 //====================================================
 // 4) WAKEUP ALL BLOCKED PROCESSES ON A GIVEN CHANNEL:
 //====================================================
 // Wake up all processes sleeping on chan.
-// The queues lock must be held.
 // Ref: xv6-x86 OS code
 // chan MUST be of type "struct Env_Queue" to hold the blocked processes
 void wakeup_all(struct Channel *chan)
 {
 	//TODO: [PROJECT'24.MS1 - #12] [4] LOCKS - wakeup_all
+	acquire_spinlock(&chan->qlk);
+	while (queue_size(&chan->queue) > 0) {
+		struct Env *process_to_wakeup = dequeue(&chan->queue);
+		sched_wakeup_lockfree(process_to_wakeup);
+	}
+	release_spinlock(&chan->qlk);
+}
 
-	// To not continue if there is a process currently going to sleep
-	acquire_spinlock(&ProcessQueues.qlock);
-
-	struct Env_Queue *blocked_queue = &chan->queue;
+//==================================================
+// 5) MOVE BLOCKED PROCESSES TO ANOTHER CHANNEL:
+//==================================================
+// 2026: wait morphing: move at most count processes blocked on 'from' to 'to'
+// (e.g. from a condition to the lock they must get after it's signaled)
+// without waking them up. Returns the # moved processes.
+int chan_move_waiters(struct Channel *from, struct Channel *to, int count)
+{
+	struct Env_Queue moved;
+	init_queue(&moved);
 
-	while (queue_size(blocked_queue) > 0) {
-		struct Env *process_to_wakeup = dequeue(blocked_queue);
-		sched_insert_ready(process_to_wakeup);
+	acquire_spinlock(&ProcessQueues.qlock);
+	{
+		acquire_spinlock(&from->qlk);
+		while (queue_size(&moved) < count && queue_size(&from->queue) > 0) {
+			enqueue(&moved, dequeue(&from->queue));
+		}
+		release_spinlock(&from->qlk);
+
+		int num_moved = queue_size(&moved);
+		if (num_moved > 0)
+		{
+			acquire_spinlock(&to->qlk);
+			while (queue_size(&moved) > 0) {
+				struct Env *env = dequeue(&moved);
+				env->blocked_chan = to;
+				enqueue(&to->queue, env);
+			}
+			release_spinlock(&to->qlk);
+			chan_link_blocked(to);
+			chan_unlink_if_empty(from);
+		}
+		count = num_moved;
 	}
+	release_spinlock(&ProcessQueues.qlock);
+	return count;
+}
 
-	// To re-enable other processes to sleep
+//==================================================
+// 6) PRINT ALL BLOCKED PROCESSES BY CHANNEL:
+//==================================================
+void print_blocked_channels()
+{
+	acquire_spinlock(&ProcessQueues.qlock);
+	{
+		sched_drain_wakeups();
+		uint32 on_channels = 0;
+		cprintf("Total blocked processes = %d\n", ProcessQueues.num_blocked);
+		for (struct Channel *chan = blocked_channels; chan != NULL; chan = chan->next_blocked)
+		{
+			acquire_spinlock(&chan->qlk);
+			cprintf("%s [%d]:\n", chan->name, queue_size(&chan->queue));
+			struct Env *env;
+			LIST_FOREACH(env, &chan->queue)
+			{
+				cprintf("	[%d] %s\n", env->env_id, env->prog_name);
+			}
+			on_channels += queue_size(&chan->queue);
+			release_spinlock(&chan->qlk);
+		}
+		//their queues live in the user semaphores (user memory)
+		if (ProcessQueues.num_blocked > on_channels)
+			cprintf("user semaphores [%d]\n", ProcessQueues.num_blocked - on_channels);
+	}
 	release_spinlock(&ProcessQueues.qlock);
-}
\ No newline at end of file
+}
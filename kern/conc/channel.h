@@ -17,13 +17,22 @@ struct Channel
 {
 	struct Env_Queue queue;	//queue of blocked processes waiting on this channel
 	char name[NAMELEN];     //channel name
+	struct spinlock qlk;	//2026: protects the queue (so that a wakeup doesn't need the ProcessQueues.qlock)
+	struct Channel *prev_blocked, *next_blocked;	//2026: link in the list of channels having blocked processes
 };
 void init_channel(struct Channel *chan, char *name);
+
+//2026: channels having blocked processes (protected by ProcessQueues.qlock)
+struct Channel *blocked_channels;
+void print_blocked_channels();
+void chan_unlink_if_empty(struct Channel *chan);
 //===================================================================================
 
 void sleep(struct Channel *chan, struct spinlock* lk); 	//block the running process on the given channel (queue) using the given lk
-void wakeup_one(struct Channel *chan);					//wakeup ONE blocked process on the given channel (queue)
+int sleep_timeout(struct Channel *chan, struct spinlock* lk, uint32 timeout_ticks);	//2026: same, for at most the given # ticks (returns 1 if timed out)
+struct Env* wakeup_one(struct Channel *chan);			//wakeup ONE blocked process on the given channel (queue) & return it (2026)
 void wakeup_all(struct Channel *chan);					//wakeup ALL blocked processes on the given channel (queue)
+int chan_move_waiters(struct Channel *from, struct Channel *to, int count);	//2026: move blocked processes to another channel (wait morphing)
 
 
 #endif /* KERN_CONC_CHANNEL_H_ */
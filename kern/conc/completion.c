@@ -0,0 +1,62 @@
+// 2026: Completions: wait for an event to be done
+
+#include "inc/types.h"
+#include "inc/environment_definitions.h"
+#include "inc/assert.h"
+#include "inc/string.h"
+#include "completion.h"
+#include "channel.h"
+
+void init_completion(struct completion *cmp, char *name)
+{
+	init_channel(&(cmp->chan), "completion channel");
+	init_spinlock(&(cmp->lk), "lock of completion");
+	strcpy(cmp->name, name);
+	cmp->done = 0;
+}
+
+//Reuse it for a new event (no process should be waiting)
+void reinit_completion(struct completion *cmp)
+{
+	acquire_spinlock(&cmp->lk);
+	cmp->done = 0;
+	release_spinlock(&cmp->lk);
+}
+
+//Block till it's completed (consumes one completion)
+void wait_for_completion(struct completion *cmp)
+{
+	assert(cmp);
+
+	acquire_spinlock(&cmp->lk);
+	while (cmp->done == 0) {
+		sleep(&cmp->chan, &cmp->lk);
+	}
+	if (cmp->done != COMPLETION_ALL)
+		cmp->done--;
+	release_spinlock(&cmp->lk);
+}
+
+//Let ONE waiter (the current or next one) pass
+//Can be called from an interrupt handler
+void complete(struct completion *cmp)
+{
+	assert(cmp);
+
+	acquire_spinlock(&cmp->lk);
+	if (cmp->done != COMPLETION_ALL)
+		cmp->done++;
+	wakeup_one(&cmp->chan);
+	release_spinlock(&cmp->lk);
+}
+
+//Let ALL the current & next waiters pass (till it's reinitialized)
+void complete_all(struct completion *cmp)
+{
+	assert(cmp);
+
+	acquire_spinlock(&cmp->lk);
+	cmp->done = COMPLETION_ALL;
+	wakeup_all(&cmp->chan);
+	release_spinlock(&cmp->lk);
+}
@@ -0,0 +1,27 @@
+// 2026: Completions: wait for an event to be done
+#ifndef KERN_CONC_COMPLETION_H_
+#define KERN_CONC_COMPLETION_H_
+
+#include <kern/conc/spinlock.h>
+#include <kern/conc/channel.h>
+#include <kern/cpu/sched_helpers.h>
+
+//Unlike a bare channel, a completion remembers that the event is done: a
+//process that waits after it's completed doesn't block (no missed wakeup).
+struct completion
+{
+	uint32 done;			// # completions not yet consumed (COMPLETION_ALL: all waiters pass)
+	struct spinlock lk; 	// spinlock protecting done
+	struct Channel chan;	// channel to hold all blocked processes on this completion
+	// For debugging:
+	char name[NAMELEN];     // Name of completion.
+};
+#define COMPLETION_ALL	0xFFFFFFFF
+
+void init_completion(struct completion *cmp, char *name);
+void reinit_completion(struct completion *cmp);
+void wait_for_completion(struct completion *cmp);
+void complete(struct completion *cmp);
+void complete_all(struct completion *cmp);
+
+#endif /*KERN_CONC_COMPLETION_H_*/
@@ -0,0 +1,106 @@
+// 2026: Futexes: blocking for user-level synchronization
+
+#include "inc/types.h"
+#include "inc/error.h"
+#include "inc/environment_definitions.h"
+#include "inc/assert.h"
+#include "futex.h"
+#include "channel.h"
+#include "../cpu/sched.h"
+#include "../mem/shared_memory_manager.h"
+#include "../proc/user_environment.h"
+
+//===============================
+// 1) INITIALIZE THE FUTEXES:
+//===============================
+void futex_init()
+{
+	for (int i = 0; i < FUTEX_HASH_SIZE; i++)
+	{
+		init_spinlock(&futex_table[i].lk, "futex bucket lock");
+		init_channel(&futex_table[i].chan, "futex");
+	}
+}
+
+static struct futex_bucket* futex_bucket_of(int32 share, uint32 offset)
+{
+	uint32 h = (uint32)share * 2654435761u ^ (offset >> 2);
+	return &futex_table[h % FUTEX_HASH_SIZE];
+}
+
+static int futex_key(uint32 *uaddr, int32 *share, uint32 *offset)
+{
+	if ((uint32)uaddr % sizeof(uint32) != 0 || (uint32)uaddr >= USER_TOP)
+		return E_INVAL;
+	return getSharedObjectKey(get_cpu_proc(), (uint32)uaddr, share, offset);
+}
+
+//===============================
+// 2) WAIT ON A FUTEX:
+//===============================
+//Block the current env on the futex at uaddr if it still holds val
+//(i.e. the user saw val and decided to sleep: if it's changed since, a wakeup
+//may be already missed, so it returns E_FUTEX_AGAIN to let the user recheck)
+//RETURN: 0 when woken up, E_FUTEX_AGAIN, or an error if uaddr isn't a shared word
+int futex_wait(uint32 *uaddr, uint32 val)
+{
+	int32 share;
+	uint32 offset;
+	int ret = futex_key(uaddr, &share, &offset);
+	if (ret != 0)
+		return ret;
+
+	struct futex_bucket *b = futex_bucket_of(share, offset);
+	acquire_spinlock(&b->lk);
+	{
+		//the waker changes the value before taking the bucket lock: checking
+		//it under the lock can't miss the wakeup
+		if (*(volatile uint32*)uaddr != val)
+		{
+			release_spinlock(&b->lk);
+			return E_FUTEX_AGAIN;
+		}
+		struct Env *cur = get_cpu_proc();
+		cur->futex_share = share;
+		cur->futex_offset = offset;
+		sleep(&b->chan, &b->lk);
+	}
+	release_spinlock(&b->lk);
+	return 0;
+}
+
+//===============================
+// 3) WAKEUP FUTEX WAITERS:
+//===============================
+//Wakeup at most count envs blocked on the futex at uaddr
+//RETURN: # woken up envs, or an error if uaddr isn't a shared word
+int futex_wake(uint32 *uaddr, int count)
+{
+	int32 share;
+	uint32 offset;
+	int ret = futex_key(uaddr, &share, &offset);
+	if (ret != 0)
+		return ret;
+
+	int woken = 0;
+	struct futex_bucket *b = futex_bucket_of(share, offset);
+	acquire_spinlock(&b->lk);
+	acquire_spinlock(&b->chan.qlk);
+	{
+		struct Env *env = LIST_FIRST(&b->chan.queue);
+		while (env != NULL && woken < count)
+		{
+			struct Env *next = LIST_NEXT(env);
+			if (env->futex_share == share && env->futex_offset == offset)
+			{
+				remove_from_queue(&b->chan.queue, env);
+				sched_wakeup_lockfree(env);
+				woken++;
+			}
+			env = next;
+		}
+	}
+	release_spinlock(&b->chan.qlk);
+	release_spinlock(&b->lk);
+	return woken;
+}
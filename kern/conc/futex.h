@@ -0,0 +1,26 @@
+// 2026: Futexes: blocking for user-level synchronization
+#ifndef KERN_CONC_FUTEX_H_
+#define KERN_CONC_FUTEX_H_
+
+#include <kern/conc/spinlock.h>
+#include <kern/conc/channel.h>
+
+//A futex is any aligned 32-bit word in a shared object. It's identified by
+//(shared object ID, offset of the word inside it) so that it's the same futex
+//for all the envs sharing the object whatever the VA they map it at.
+//Waiters are kept in a hashed table of channels: a bucket holds the waiters on
+//all the futexes hashed to it, each env remembers the futex it waits on.
+#define FUTEX_HASH_SIZE 64
+
+struct futex_bucket
+{
+	struct spinlock lk;		//serializes checking the futex value against the wakeups
+	struct Channel chan;	//waiters on the futexes hashed to this bucket
+};
+struct futex_bucket futex_table[FUTEX_HASH_SIZE];
+
+void futex_init();
+int futex_wait(uint32 *uaddr, uint32 val);
+int futex_wake(uint32 *uaddr, int count);
+
+#endif /* KERN_CONC_FUTEX_H_ */
@@ -0,0 +1,248 @@
+// 2026: Message passing between envs with zero-copy page transfer
+
+#include "inc/types.h"
+#include "inc/error.h"
+#include "inc/environment_definitions.h"
+#include "inc/assert.h"
+#include "ipc.h"
+#include "channel.h"
+#include "../cpu/sched.h"
+#include "../mem/kheap.h"
+#include "../mem/memory_manager.h"
+#include "../mem/working_set_manager.h"
+#include "../disk/pagefile_manager.h"
+#include "../proc/user_environment.h"
+
+//===============================
+// 1) INITIALIZE THE IPC:
+//===============================
+void ipc_init()
+{
+	for (int i = 0; i < IPC_HASH_SIZE; i++)
+	{
+		init_spinlock(&ipc_table[i].lk, "ipc bucket lock");
+		init_channel(&ipc_table[i].chan, "ipc");
+	}
+}
+
+static struct ipc_bucket* ipc_bucket_of(struct Env *e)
+{
+	return &ipc_table[ENVX(e->env_id) % IPC_HASH_SIZE];
+}
+
+//Pages can be moved from/to the page allocator area of the user heap only,
+//and must be allocated there (marked)
+static int ipc_check_range(struct Env *e, uint32 va, uint32 npages)
+{
+	if (npages == 0)
+		return 0;
+	if (va % PAGE_SIZE != 0 || va < e->uheap_limit || va >= USER_HEAP_MAX ||
+			npages > (USER_HEAP_MAX - va) / PAGE_SIZE)
+		return E_INVAL;
+	for (uint32 i = 0; i < npages; i++, va += PAGE_SIZE)
+	{
+		uint32 *ptr_page_table = NULL;
+		get_page_table(e->env_page_directory, va, &ptr_page_table);
+		if (ptr_page_table == NULL || !(ptr_page_table[PTX(va)] & PERM_USER_MARKED))
+			return E_INVAL;
+	}
+	return 0;
+}
+
+//===============================
+// 2) MOVE A PAGE:
+//===============================
+//Detach the page at va from the current env (the sender): it keeps the page
+//allocated, but its content is gone (a new frame is placed at its next access)
+static void ipc_take_page(struct Env *cur, uint32 va, struct ipc_page *p)
+{
+	uint32 *ptr_page_table = NULL;
+	p->frame = get_frame_info(cur->env_page_directory, va, &ptr_page_table);
+	p->perms = 0;
+	if (p->frame != NULL)
+	{
+		p->perms = ptr_page_table[PTX(va)] & (PERM_WRITEABLE | PERM_USER | PERM_USED | PERM_MODIFIED | PERM_COW);
+		//keep the frame while it's on its way
+		p->frame->references++;
+		env_page_ws_invalidate(cur, va);
+		unmap_frame(cur->env_page_directory, va);
+	}
+	p->dfn = pf_take_env_page(cur, va);
+}
+
+//Attach the page at va of the current env (the receiver), replacing its page
+//there. If its WS is full, the page is placed in its page file instead
+//(written only if it's not already there)
+static void ipc_put_page(struct Env *cur, uint32 va, struct ipc_page *p)
+{
+	uint32 *ptr_page_table = NULL;
+	if (get_frame_info(cur->env_page_directory, va, &ptr_page_table) != NULL)
+	{
+		env_page_ws_invalidate(cur, va);
+		unmap_frame(cur->env_page_directory, va);
+	}
+	pf_remove_env_page(cur, va);
+	if (p->dfn != 0 && pf_put_env_page(cur, va, p->dfn) != 0)
+		panic("ipc_put_page: failed to create a page file table");
+
+	if (p->frame == NULL)
+		return;
+	if (env_page_ws_add(cur, va, p->frame))
+		map_frame(cur->env_page_directory, p->frame, va, p->perms);
+	else if ((p->perms & PERM_MODIFIED) || p->dfn == 0)
+	{
+		if (pf_update_env_page(cur, va, p->frame) == E_NO_PAGE_FILE_SPACE)
+			panic("ipc_put_page: page file out of space!");
+	}
+	decrement_references(p->frame);
+}
+
+//Drop the pages of a message that won't be received
+static void ipc_free_pages(struct ipc_page *pages, uint32 npages)
+{
+	for (uint32 i = 0; i < npages; i++)
+	{
+		if (pages[i].frame != NULL)
+			decrement_references(pages[i].frame);
+		free_disk_frame(pages[i].dfn);
+	}
+	kfree(pages);
+}
+
+//===============================
+// 3) SEND A MESSAGE:
+//===============================
+//Send the value & the npages at srcva (0 pages: value only) to the env envid,
+//blocking till it receives.
+//The pages move: the sender keeps them allocated, their content is gone.
+//RETURN: # pages moved (at most the # the receiver asked for), or an error
+int ipc_send(int32 envid, uint32 value, uint32 srcva, uint32 npages)
+{
+	struct Env *cur = get_cpu_proc();
+	struct Env *e;
+	if (envid2env(envid, &e, 0) != 0 || e == cur)
+		return E_BAD_ENV;
+	int ret = ipc_check_range(cur, srcva, npages);
+	if (ret != 0)
+		return ret;
+
+	struct ipc_bucket *b = ipc_bucket_of(e);
+	acquire_spinlock(&b->lk);
+	{
+		while (e->ipc_state != IPC_RECVING)
+		{
+			if (e->env_id != envid || e->ipc_state == IPC_DEAD)
+			{
+				release_spinlock(&b->lk);
+				return E_BAD_ENV;
+			}
+			sleep(&b->chan, &b->lk);
+		}
+		//claim it: the other senders keep waiting
+		e->ipc_state = IPC_BUSY;
+		npages = MIN(npages, e->ipc_maxpages);
+	}
+	release_spinlock(&b->lk);
+
+	//detach the pages here, in the sender's address space. The receiver maps
+	//them in its own (e.g. a page may have to go to its page file)
+	struct ipc_page *pages = NULL;
+	if (npages > 0)
+	{
+		pages = kmalloc(npages * sizeof(struct ipc_page));
+		if (pages == NULL)
+		{
+			acquire_spinlock(&b->lk);
+			if (e->env_id == envid && e->ipc_state == IPC_BUSY)
+				e->ipc_state = IPC_RECVING;
+			wakeup_all(&b->chan);
+			release_spinlock(&b->lk);
+			return E_NO_MEM;
+		}
+		for (uint32 i = 0; i < npages; i++)
+			ipc_take_page(cur, srcva + i * PAGE_SIZE, &pages[i]);
+	}
+
+	acquire_spinlock(&b->lk);
+	{
+		//the receiver may have been freed meanwhile (its slot may even hold
+		//another env now): the message is dropped
+		if (e->env_id != envid || e->ipc_state != IPC_BUSY)
+		{
+			release_spinlock(&b->lk);
+			if (pages != NULL)
+				ipc_free_pages(pages, npages);
+			return E_BAD_ENV;
+		}
+		e->ipc_from = cur->env_id;
+		e->ipc_value = value;
+		e->ipc_npages = npages;
+		e->ipc_pages = pages;
+		e->ipc_state = IPC_DELIVERED;
+		wakeup_all(&b->chan);
+	}
+	release_spinlock(&b->lk);
+	return npages;
+}
+
+//===============================
+// 4) RECEIVE A MESSAGE:
+//===============================
+//Block till a message is sent to the current env. Up to maxpages pages are
+//accepted at dstva (they replace its pages there).
+//The message is left in its ipc_from, ipc_value & ipc_npages
+//RETURN: 0, or an error if the range isn't allocated in its user heap
+int ipc_recv(uint32 dstva, uint32 maxpages)
+{
+	struct Env *cur = get_cpu_proc();
+	if (dstva == 0)
+		maxpages = 0;
+	int ret = ipc_check_range(cur, dstva, maxpages);
+	if (ret != 0)
+		return ret;
+
+	struct ipc_page *pages;
+	struct ipc_bucket *b = ipc_bucket_of(cur);
+	acquire_spinlock(&b->lk);
+	{
+		cur->ipc_dstva = dstva;
+		cur->ipc_maxpages = maxpages;
+		cur->ipc_state = IPC_RECVING;
+		wakeup_all(&b->chan);
+		while (cur->ipc_state != IPC_DELIVERED)
+			sleep(&b->chan, &b->lk);
+		cur->ipc_state = IPC_IDLE;
+		pages = cur->ipc_pages;
+		cur->ipc_pages = NULL;
+	}
+	release_spinlock(&b->lk);
+
+	if (pages != NULL)
+	{
+		for (uint32 i = 0; i < cur->ipc_npages; i++)
+			ipc_put_page(cur, dstva + i * PAGE_SIZE, &pages[i]);
+		kfree(pages);
+	}
+	return 0;
+}
+
+//===============================
+// 5) FREE THE ENV:
+//===============================
+//Called by env_free(): its blocked senders give up, pages sent to it are dropped
+void ipc_env_free(struct Env *e)
+{
+	struct ipc_page *pages;
+	struct ipc_bucket *b = ipc_bucket_of(e);
+	acquire_spinlock(&b->lk);
+	{
+		e->ipc_state = IPC_DEAD;
+		pages = e->ipc_pages;
+		e->ipc_pages = NULL;
+		wakeup_all(&b->chan);
+	}
+	release_spinlock(&b->lk);
+
+	if (pages != NULL)
+		ipc_free_pages(pages, e->ipc_npages);
+}
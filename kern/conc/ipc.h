@@ -0,0 +1,38 @@
+// 2026: Message passing between envs (sys_ipc_send / sys_ipc_recv)
+#ifndef KERN_CONC_IPC_H_
+#define KERN_CONC_IPC_H_
+
+#include <kern/conc/spinlock.h>
+#include <kern/conc/channel.h>
+
+//A message is a word, passed in registers, and optionally a range of user
+//heap pages that MOVE from the sender to the receiver: their frames (and/or
+//page file pages) are remapped, nothing is copied.
+//Sending blocks till the receiver is in sys_ipc_recv (rendezvous).
+//A receiver & the senders to it wait in the bucket of the receiver: the
+//senders for it to receive, it for a message.
+#define IPC_HASH_SIZE 64
+
+struct ipc_bucket
+{
+	struct spinlock lk;		//protects the IPC state of the receivers hashed to this bucket
+	struct Channel chan;	//their senders & themselves
+};
+struct ipc_bucket ipc_table[IPC_HASH_SIZE];
+
+//A page on its way to the receiver: detached from the sender, it's mapped
+//by the receiver in its own address space (its WS & page file are updated
+//there only)
+struct ipc_page
+{
+	struct FrameInfo *frame;	//its frame if it's in RAM (one reference is held)
+	uint32 perms;				//its PTE permissions in the sender
+	uint32 dfn;					//its disk page if any (taken from the sender)
+};
+
+void ipc_init();
+int ipc_send(int32 envid, uint32 value, uint32 srcva, uint32 npages);
+int ipc_recv(uint32 dstva, uint32 maxpages);
+void ipc_env_free(struct Env *e);
+
+#endif /* KERN_CONC_IPC_H_ */
@@ -15,26 +15,46 @@
 void init_ksemaphore(struct ksemaphore *ksem, int value, char *name)
 {
 	//[PROJECT'24.MS3]
-	//COMMENT THE FOLLOWING LINE BEFORE START CODING
-	panic("init_ksemaphore is not implemented yet");
-	//Your Code is Here...
+	init_channel(&(ksem->chan), "semaphore channel");
+	init_spinlock(&(ksem->lk), "lock of semaphore");
+	strcpy(ksem->name, name);
+	ksem->count = value;
+	ksem->stats = lockstat_class(LOCKSTAT_SEMAPHORE, name);
 }
 
+//-ve count: # blocked processes. A signal wakes up exactly one of them and
+//its unit is handed to it (i.e. no need to recheck the count after waking up)
 void wait_ksemaphore(struct ksemaphore *ksem)
 {
 	//[PROJECT'24.MS3]
-	//COMMENT THE FOLLOWING LINE BEFORE START CODING
-	panic("wait_ksemaphore is not implemented yet");
-	//Your Code is Here...
+	assert(ksem);
 
+	acquire_spinlock(&ksem->lk);
+	ksem->count--;
+	uint8 contended = (ksem->count < 0);
+	uint64 wait_start = contended ? read_tsc() : 0;
+	if (contended)
+	{
+		lockstat_blocked(ksem->stats);
+		sleep(&ksem->chan, &ksem->lk);
+	}
+	lockstat_acquired(ksem->stats, contended, wait_start);
+	release_spinlock(&ksem->lk);
 }
 
+//Can be called from an interrupt handler (e.g. to signal a KBD/disk interrupt)
 void signal_ksemaphore(struct ksemaphore *ksem)
 {
 	//[PROJECT'24.MS3]
-	//COMMENT THE FOLLOWING LINE BEFORE START CODING
-	panic("signal_ksemaphore is not implemented yet");
-	//Your Code is Here...
+	assert(ksem);
+
+	acquire_spinlock(&ksem->lk);
+	ksem->count++;
+	if (ksem->count <= 0)
+	{
+		wakeup_one(&ksem->chan);
+	}
+	release_spinlock(&ksem->lk);
 }
 
 
@@ -14,6 +14,7 @@ struct ksemaphore
 
 	// For debugging:
 	char name[NAMELEN];        	// Name of semaphore.
+	struct lock_class *stats;	// 2026: contention statistics of its class
 };
 
 void init_ksemaphore(struct ksemaphore *ksem, int value, char *name);
@@ -0,0 +1,120 @@
+// 2026: Lock contention statistics
+
+#include "inc/types.h"
+#include "inc/x86.h"
+#include "inc/string.h"
+#include "inc/assert.h"
+#include "lockstat.h"
+
+static struct lock_class lock_classes[LOCKSTAT_MAX_CLASSES];
+static uint32 num_lock_classes;
+//a raw lock: the class lookup is called from init_spinlock()
+static uint32 lock_classes_lock;
+
+static const char *lockstat_kind_names[] = { "spin", "sleep", "sem", "rwsleep" };
+
+//Return the class of the locks of the given kind & name (created if not exist)
+struct lock_class* lockstat_class(uint8 kind, const char *name)
+{
+	struct lock_class *cls = NULL;
+	uint32 eflags = read_eflags();
+	cli();
+	while (xchg(&lock_classes_lock, 1) != 0)
+		cpu_relax();
+	{
+		for (int i = 0; i < num_lock_classes; i++)
+		{
+			if (lock_classes[i].kind == kind && strncmp(lock_classes[i].name, name, NAMELEN) == 0)
+			{
+				cls = &lock_classes[i];
+				break;
+			}
+		}
+		if (cls == NULL)
+		{
+			if (num_lock_classes < LOCKSTAT_MAX_CLASSES)
+			{
+				cls = &lock_classes[num_lock_classes++];
+				strncpy(cls->name, name, NAMELEN);
+				cls->name[NAMELEN - 1] = '\0';
+			}
+			else
+			{
+				cls = &lock_classes[LOCKSTAT_MAX_CLASSES - 1];
+				strcpy(cls->name, "<others>");
+			}
+			cls->kind = kind;
+		}
+	}
+	lock_classes_lock = 0;
+	write_eflags(eflags);
+	return cls;
+}
+
+//Count an acquisition. If it's contended, wait_start is the time it started
+//spinning/blocking
+void lockstat_acquired(struct lock_class *cls, uint8 contended, uint64 wait_start)
+{
+	if (cls == NULL)
+		return;
+	cls->acquires++;
+	if (!contended)
+		return;
+	uint64 wait = read_tsc() - wait_start;
+	cls->contended++;
+	cls->wait_cycles += wait;
+	if (wait > cls->max_wait)
+		cls->max_wait = wait;
+}
+
+//Count a sleep on a sleeping lock/semaphore
+void lockstat_blocked(struct lock_class *cls)
+{
+	if (cls != NULL)
+		cls->blocks++;
+}
+
+void lockstat_reset()
+{
+	for (int i = 0; i < num_lock_classes; i++)
+	{
+		lock_classes[i].acquires = lock_classes[i].contended = lock_classes[i].blocks = 0;
+		lock_classes[i].wait_cycles = lock_classes[i].max_wait = 0;
+	}
+}
+
+//Print the hottest max_count classes: by total wait, then by # contentions,
+//then by # acquisitions
+static int lockstat_hotter(struct lock_class *a, struct lock_class *b)
+{
+	if (a->wait_cycles != b->wait_cycles)
+		return a->wait_cycles > b->wait_cycles;
+	if (a->contended != b->contended)
+		return a->contended > b->contended;
+	return a->acquires > b->acquires;
+}
+void lockstat_print(int max_count)
+{
+	uint8 printed[LOCKSTAT_MAX_CLASSES] = {0};
+	cprintf("%-32s %-7s %10s %10s %8s %14s %12s\n", "name", "kind", "acquires", "contended", "blocks", "wait(cycles)", "max wait");
+	for (int n = 0; n < max_count && n < num_lock_classes; n++)
+	{
+		struct lock_class *hottest = NULL;
+		int hottest_idx = -1;
+		for (int i = 0; i < num_lock_classes; i++)
+		{
+			if (printed[i] || lock_classes[i].acquires == 0)
+				continue;
+			if (hottest == NULL || lockstat_hotter(&lock_classes[i], hottest))
+			{
+				hottest = &lock_classes[i];
+				hottest_idx = i;
+			}
+		}
+		if (hottest == NULL)
+			break;
+		printed[hottest_idx] = 1;
+		cprintf("%-32s %-7s %10u %10u %8u %14llu %12llu\n", hottest->name, lockstat_kind_names[hottest->kind],
+				hottest->acquires, hottest->contended, hottest->blocks, hottest->wait_cycles, hottest->max_wait);
+	}
+}
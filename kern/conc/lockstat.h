@@ -0,0 +1,36 @@
+// 2026: Lock contention statistics
+#ifndef KERN_CONC_LOCKSTAT_H_
+#define KERN_CONC_LOCKSTAT_H_
+
+#include <inc/types.h>
+#include <inc/stdio.h>
+
+#define LOCKSTAT_SPIN		0
+#define LOCKSTAT_SLEEP		1
+#define LOCKSTAT_SEMAPHORE	2
+#define LOCKSTAT_RWSLEEP	3
+
+//Statistics are kept per lock class: all the locks of the same kind & name
+//(e.g. the queue locks of all the channels) share the same entry.
+//When the table is full, the remaining classes are counted in the last entry.
+#define LOCKSTAT_MAX_CLASSES 64
+
+struct lock_class
+{
+	char name[NAMELEN];
+	uint8 kind;
+	uint32 acquires;		//# acquisitions (waits on a semaphore)
+	uint32 contended;		//# of them that had to spin/block
+	uint32 blocks;			//# times a process blocked on them (i.e. context switches)
+	uint64 wait_cycles;		//total cycles spent spinning/blocked
+	uint64 max_wait;		//longest spin/block (cycles)
+};
+
+//Counters are updated without a lock: they are statistics, not invariants.
+struct lock_class* lockstat_class(uint8 kind, const char *name);
+void lockstat_acquired(struct lock_class *cls, uint8 contended, uint64 wait_start);
+void lockstat_blocked(struct lock_class *cls);
+void lockstat_reset();
+void lockstat_print(int max_count);
+
+#endif /* KERN_CONC_LOCKSTAT_H_ */
@@ -0,0 +1,116 @@
+// 2026: Reader-writer sleeping locks
+
+#include "inc/types.h"
+#include "inc/x86.h"
+#include "inc/environment_definitions.h"
+#include "inc/assert.h"
+#include "inc/string.h"
+#include "rwsleeplock.h"
+#include "channel.h"
+#include "../cpu/cpu.h"
+#include "../proc/user_environment.h"
+
+void init_rwsleeplock(struct rwsleeplock *rwlk, char *name)
+{
+	init_channel(&(rwlk->readers_chan), "rw sleep lock readers channel");
+	init_channel(&(rwlk->writers_chan), "rw sleep lock writers channel");
+	init_spinlock(&(rwlk->lk), "lock of rw sleep lock");
+	strcpy(rwlk->name, name);
+	rwlk->readers = 0;
+	rwlk->writing = 0;
+	rwlk->waiting_writers = 0;
+	rwlk->pid = 0;
+	rwlk->stats = lockstat_class(LOCKSTAT_RWSLEEP, name);
+}
+
+int holding_write_rwsleeplock(struct rwsleeplock *rwlk)
+{
+	int r;
+	acquire_spinlock(&(rwlk->lk));
+	r = rwlk->writing && (rwlk->pid == get_cpu_proc()->env_id);
+	release_spinlock(&(rwlk->lk));
+	return r;
+}
+//==========================================================================
+
+void acquire_read_rwsleeplock(struct rwsleeplock *rwlk)
+{
+	assert(rwlk);
+
+	acquire_spinlock(&rwlk->lk);
+
+	uint8 contended = rwlk->writing || rwlk->waiting_writers > 0;
+	uint64 wait_start = contended ? read_tsc() : 0;
+	while (rwlk->writing || rwlk->waiting_writers > 0) {
+		lockstat_blocked(rwlk->stats);
+		sleep(&rwlk->readers_chan, &rwlk->lk);
+	}
+	rwlk->readers++;
+	lockstat_acquired(rwlk->stats, contended, wait_start);
+
+	release_spinlock(&rwlk->lk);
+}
+
+void release_read_rwsleeplock(struct rwsleeplock *rwlk)
+{
+	assert(rwlk);
+
+	acquire_spinlock(&rwlk->lk);
+
+	if (rwlk->readers <= 0)
+		panic("release_read_rwsleeplock: lock \"%s\" is not held for read!", rwlk->name);
+	rwlk->readers--;
+	if (rwlk->readers == 0 && rwlk->waiting_writers > 0) {
+		wakeup_one(&rwlk->writers_chan);
+	}
+
+	release_spinlock(&rwlk->lk);
+}
+
+void acquire_write_rwsleeplock(struct rwsleeplock *rwlk)
+{
+	assert(rwlk);
+
+	if (holding_write_rwsleeplock(rwlk)) {
+		panic("acquire_write_rwsleeplock: lock \"%s\" is already held by the same process.", rwlk->name);
+	}
+
+	acquire_spinlock(&rwlk->lk);
+
+	uint8 contended = rwlk->writing || rwlk->readers > 0;
+	uint64 wait_start = contended ? read_tsc() : 0;
+	rwlk->waiting_writers++;
+	while (rwlk->writing || rwlk->readers > 0) {
+		lockstat_blocked(rwlk->stats);
+		sleep(&rwlk->writers_chan, &rwlk->lk);
+	}
+	rwlk->waiting_writers--;
+	rwlk->writing = 1;
+	rwlk->pid = get_cpu_proc()->env_id;
+	lockstat_acquired(rwlk->stats, contended, wait_start);
+
+	release_spinlock(&rwlk->lk);
+}
+
+void release_write_rwsleeplock(struct rwsleeplock *rwlk)
+{
+	assert(rwlk);
+
+	if (!holding_write_rwsleeplock(rwlk)) {
+		panic("release_write_rwsleeplock: lock \"%s\" is either not held or held by another process!", rwlk->name);
+	}
+
+	acquire_spinlock(&rwlk->lk);
+
+	rwlk->pid = 0;
+	rwlk->writing = 0;
+	//the next writer first (if any), else all the readers
+	if (rwlk->waiting_writers > 0) {
+		wakeup_one(&rwlk->writers_chan);
+	}
+	else {
+		wakeup_all(&rwlk->readers_chan);
+	}
+
+	release_spinlock(&rwlk->lk);
+}
@@ -0,0 +1,32 @@
+// 2026: Long-term reader-writer locks for processes
+#ifndef KERN_CONC_RWSLEEPLOCK_H_
+#define KERN_CONC_RWSLEEPLOCK_H_
+
+#include <kern/conc/spinlock.h>
+#include <kern/conc/channel.h>
+#include <kern/cpu/sched_helpers.h>
+
+//Many readers OR one writer. Writers are preferred: once a writer waits, no
+//new reader can get in (so that a stream of readers can't starve it).
+struct rwsleeplock
+{
+	int readers;				// # processes holding it for read
+	bool writing;				// Is it held for write?
+	int waiting_writers;		// # processes blocked to write
+	struct spinlock lk; 		// spinlock protecting this lock
+	struct Channel readers_chan;	// blocked readers
+	struct Channel writers_chan;	// blocked writers
+	// For debugging:
+	char name[NAMELEN];    		// Name of lock.
+	int pid;           			// Process holding it for write
+	struct lock_class *stats;	// contention statistics of its class
+};
+
+void init_rwsleeplock(struct rwsleeplock *rwlk, char *name);
+void acquire_read_rwsleeplock(struct rwsleeplock *rwlk);
+void release_read_rwsleeplock(struct rwsleeplock *rwlk);
+void acquire_write_rwsleeplock(struct rwsleeplock *rwlk);
+void release_write_rwsleeplock(struct rwsleeplock *rwlk);
+int  holding_write_rwsleeplock(struct rwsleeplock *rwlk);
+
+#endif /*KERN_CONC_RWSLEEPLOCK_H_*/
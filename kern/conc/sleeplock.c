@@ -19,7 +19,20 @@ void init_sleeplock(struct sleeplock *lk, char *name)
 	strcpy(lk->name, name);
 	lk->locked = 0;
 	lk->pid = 0;
+	lk->stats = lockstat_class(LOCKSTAT_SLEEP, name);
 }
+//2026: direct hand-off: release_sleeplock() gives the lock to the first
+//blocked process (if any) & wakes up only that one (no thundering herd)
+static uint8 sleeplock_handoff = 1;
+void enableSleeplockHandoff(uint8 enable)
+{
+	sleeplock_handoff = enable;
+}
+uint8 isSleeplockHandoffEnabled()
+{
+	return sleeplock_handoff;
+}
+
 int holding_sleeplock(struct sleeplock *lk)
 {
 	int r;
@@ -30,6 +43,53 @@ int holding_sleeplock(struct sleeplock *lk)
 }
 //==========================================================================
 
+//2026: get the lock (its spinlock must be held). It's either free, or handed to
+//us by the releaser while we're blocked (the pid is set to ours)
+static void sleeplock_wait_locked(struct sleeplock *lk)
+{
+	struct Env *env = get_cpu_proc();
+
+	uint8 contended = lk->locked;
+	uint64 wait_start = contended ? read_tsc() : 0;
+	while (!(lk->locked && lk->pid == env->env_id)) {
+		if (!lk->locked) {
+			lk->locked = 1;
+			lk->pid = env->env_id;
+			break;
+		}
+		lockstat_blocked(lk->stats);
+		sleep(&lk->chan, &lk->lk);
+	}
+	lockstat_acquired(lk->stats, contended, wait_start);
+
+	// set debug information
+	strncpy(lk->name, env->prog_name, NAMELEN);
+}
+
+//2026: release the lock (its spinlock must be held): hand it to the first
+//blocked process if any
+static void sleeplock_release_locked(struct sleeplock *lk)
+{
+	// clear debug information
+	lk->pid = 0;
+	memset(lk->name, '\0', NAMELEN);
+
+	if (!sleeplock_handoff) {
+		lk->locked = 0;
+		if (queue_size(&lk->chan.queue) > 0) {
+			wakeup_all(&lk->chan);
+		}
+		return;
+	}
+
+	// it can't run before we release the spinlock: set the owner after waking it up
+	struct Env *next_owner = wakeup_one(&lk->chan);
+	if (next_owner != NULL)
+		lk->pid = next_owner->env_id;
+	else
+		lk->locked = 0;
+}
+
 void acquire_sleeplock(struct sleeplock *lk)
 {
 	//TODO: [PROJECT'24.MS1 - #13] [4] LOCKS - acquire_sleeplock
@@ -45,15 +105,7 @@ void acquire_sleeplock(struct sleeplock *lk)
 
 	acquire_spinlock(&lk->lk);
 
-	while (lk->locked) {
-		sleep(&lk->chan, &lk->lk);
-	}
-	lk->locked = 1;
-
-	// set debug information
-	struct Env *env = get_cpu_proc();
-	lk->pid = env->env_id;
-	strncpy(lk->name, env->prog_name, NAMELEN);
+	sleeplock_wait_locked(lk);
 
 	release_spinlock(&lk->lk);
 }
@@ -74,15 +126,52 @@ void release_sleeplock(struct sleeplock *lk)
 
 	acquire_spinlock(&lk->lk);
 
-	// clear debug information
-	lk->pid = 0;
-	memset(lk->name, '\0', NAMELEN);
+	sleeplock_release_locked(lk);
 
-	lk->locked = 0;
-	if (queue_size(&lk->chan.queue) > 0) {
-		wakeup_all(&lk->chan);
+	release_spinlock(&lk->lk);
+}
+
+//==========================================================================
+//2026: Condition waits on a sleep lock (with wait morphing)
+//==========================================================================
+//Atomically release the (held) lock & block on the given condition channel.
+//Returns holding the lock again.
+void sleep_sleeplock(struct Channel *chan, struct sleeplock *lk)
+{
+	assert(lk);
+
+	if (!holding_sleeplock(lk)) {
+		panic("sleep_sleeplock: lock \"%s\" is not held!", lk->name);
 	}
 
+	acquire_spinlock(&lk->lk);
+
+	sleeplock_release_locked(lk);
+	sleep(chan, &lk->lk);
+	//either moved to the lock & handed it, or woken up directly
+	sleeplock_wait_locked(lk);
+
+	release_spinlock(&lk->lk);
+}
+
+//Wakeup at most count processes blocked on the condition channel. The caller
+//holds the lock they need: rather than waking them up to block again on it,
+//they are moved to its queue & get it one by one as it's released.
+void wakeup_sleeplock(struct Channel *chan, struct sleeplock *lk, int count)
+{
+	assert(lk);
+
+	if (!holding_sleeplock(lk)) {
+		panic("wakeup_sleeplock: lock \"%s\" is not held!", lk->name);
+	}
+
+	acquire_spinlock(&lk->lk);
+	if (sleeplock_handoff)
+		chan_move_waiters(chan, &lk->chan, count);
+	else
+	{
+		for (int i = 0; i < count && wakeup_one(chan) != NULL; i++) ;
+	}
 	release_spinlock(&lk->lk);
 }
 
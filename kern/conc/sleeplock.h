@@ -18,6 +18,7 @@ struct sleeplock
 	// For debugging:
 	char name[NAMELEN];    	// Name of lock.
 	int pid;           		// Process holding lock
+	struct lock_class *stats;	// 2026: contention statistics of its class
 };
 
 void init_sleeplock(struct sleeplock *lk, char *name);
@@ -27,6 +28,12 @@ int  holding_sleeplock(struct sleeplock *lk);
 void acquire_sleeplock(struct sleeplock *lk);
 void release_sleeplock(struct sleeplock *lk);
 
+//2026
+void sleep_sleeplock(struct Channel *chan, struct sleeplock *lk);					//condition wait
+void wakeup_sleeplock(struct Channel *chan, struct sleeplock *lk, int count);	//condition signal (wait morphing)
+void enableSleeplockHandoff(uint8 enable);
+uint8 isSleeplockHandoffEnabled();
+
 void printcallstack_sleeplock(const struct sleeplock *lk);
 
 #endif /*KERN_CONC_SLEEPLOCK_H_*/
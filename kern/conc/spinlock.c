@@ -18,7 +18,9 @@ void init_spinlock(struct spinlock *lk, char *name)
 {
 	strcpy(lk->name, name);
 	lk->locked = 0;
+	lk->next_ticket = lk->now_serving = 0;
 	lk->cpu = 0;
+	lk->stats = lockstat_class(LOCKSTAT_SPIN, name);
 }
 
 // Acquire the lock.
@@ -34,8 +36,21 @@ void acquire_spinlock(struct spinlock *lk)
 
 	//cprintf("\nAttempt to acquire SPIN lock [%s] by [%d]\n", lk->name, myproc() != NULL? myproc()->env_id : 0);
 
-	// The xchg is atomic.
-	while(xchg(&lk->locked, 1) != 0) ;
+	//2026: take a ticket (the xadd is atomic) & wait for our turn.
+	//The spinning is timed only if it's not our turn at once.
+	uint32 ticket = xadd(&lk->next_ticket, 1);
+	volatile uint32 *now_serving = &lk->now_serving;
+	uint8 contended = 0;
+	uint64 wait_start = 0;
+	if (*now_serving != ticket)
+	{
+		contended = 1;
+		wait_start = read_tsc();
+		while (*now_serving != ticket)
+			cpu_relax();
+	}
+	lk->locked = 1;
+	lockstat_acquired(lk->stats, contended, wait_start);
 
 	//cprintf("SPIN lock [%s] is ACQUIRED  by [%d]\n", lk->name, myproc() != NULL? myproc()->env_id : 0);
 
@@ -46,7 +61,9 @@ void acquire_spinlock(struct spinlock *lk)
 
 	// Record info about lock acquisition for debugging.
 	lk->cpu = mycpu();
+#if LOCK_DEBUG
 	getcallerpcs(&lk, lk->pcs);
+#endif
 
 }
 
@@ -72,6 +89,8 @@ void release_spinlock(struct spinlock *lk)
 	// This code can't use a C assignment, since it might
 	// not be atomic. A real OS would use C atomics here.
 	asm volatile("movl $0, %0" : "+m" (lk->locked) : );
+	//2026: hand it to the next ticket (only the holder writes now_serving)
+	asm volatile("incl %0" : "+m" (lk->now_serving) : : "memory");
 
 	popcli();
 }
@@ -6,16 +6,28 @@
 #ifndef KERN_CONC_SPINLOCK_H_
 #define KERN_CONC_SPINLOCK_H_
 
+#include <kern/conc/lockstat.h>
+
+//2026: record the call stack of each acquisition in pcs[] (set by "make LOCKDEBUG=1")
+#ifndef LOCK_DEBUG
+#define LOCK_DEBUG 0
+#endif
+
 //=======================================================================
 //TODO: [PROJECT'24.MS1 - #00 GIVENS] [4] LOCKS - SpinLock Implementation
+//2026: a ticket lock: CPUs get the lock in the order they asked for it (FIFO)
+//and spin on reading now_serving only (no locked bus cycle while waiting)
 struct spinlock {
   uint32 locked;       	// Is the lock held?
+  uint32 next_ticket;	// 2026: ticket of the next CPU asking for it
+  uint32 now_serving;	// 2026: ticket of the CPU holding it (or the next to hold it)
 
   // For debugging:
   char name[NAMELEN];	// Name of lock.
   struct cpu *cpu;   	// The cpu holding the lock.
   uint32 pcs[10];      	// The call stack (an array of program counters)
                      	// that locked the lock.
+  struct lock_class *stats;	// 2026: contention statistics of its class
 };
 void init_spinlock(struct spinlock *lk, char *name);
 void acquire_spinlock(struct spinlock *lk);
@@ -42,6 +42,8 @@ mc146818_write(unsigned reg, unsigned datum)
 void kclock_init()
 {
 	ticks = 0;
+	kclock_tickless = 0;		//2026: off by default (see the tickless command)
+	kclock_stretch = 1;
 	irq_install_handler(0, &clock_interrupt_handler);
 }
 void
@@ -134,6 +136,7 @@ kclock_stop(void)
 	/*Mask the IRQ0 (Timer Interrupt)*/
 	//irq_setmask_8259A(0xFFFF);
 	irq_set_mask(0);
+	kclock_stretch = 1;
 
 //	uint16 cnt0 = kclock_read_cnt0() ;
 //	cprintf("Timer STOPPED: Counter0 Value = %x\n", cnt0 );
@@ -220,6 +223,7 @@ void kclock_set_quantum(uint8 quantum_in_ms)
 //		if (cnt%2 == 1)
 //			cnt++;
 		int cnt = NUM_CLKS_PER_QUANTUM(quantum_in_ms);
+		kclock_quantum = quantum_in_ms;
 
 
 		//cprintf("QUANTUM is set to %d ms (%d)\n", quantum_in_ms, TIMER_DIV((1000/quantum_in_ms)));
@@ -234,6 +238,37 @@ void kclock_set_quantum(uint8 quantum_in_ms)
 		panic("attempt to set the CPU quantum by too large value. Quantum should be between 1 ms and %d ms", QUANTUM_LIMIT - 1);
 	}
 }
+
+/*2026*/
+//Stretch the clock interval of the current quantum to (at most) the given # of
+//quanta (bounded by the largest quantum the PIT can count). Used when a single
+//env is runnable: the interrupts in-between would just pick it again.
+void kclock_stretch_quantum(uint8 max_stretch)
+{
+	uint8 quantum = kclock_quantum;
+	int stretch = max_stretch;
+	while (stretch > 1 && !IS_VALID_QUANTUM(quantum * stretch))
+	{
+		stretch--;
+	}
+	if (stretch <= 1)
+		return;
+
+	kclock_set_quantum(quantum * stretch);
+	kclock_quantum = quantum;
+	kclock_stretch = stretch;
+}
+
+//Shrink a stretched clock interval back to a single quantum (starting from now)
+//without affecting the interrupt status. Called when another env becomes ready.
+void kclock_unstretch(void)
+{
+	if (kclock_stretch <= 1)
+		return;
+	kclock_stretch = 1;
+	outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
+	kclock_write_cnt0_LSB_first(NUM_CLKS_PER_QUANTUM(kclock_quantum)) ;
+}
 //==============
 
 
@@ -49,6 +49,25 @@ void kclock_write_cnt0_LSB_first(uint16 val);
 //2018
 void kclock_set_quantum(uint8 quantum_in_ms);
 
+/*2026*/
+/********* Tickless idle & dynamic quantum *************/
+#define TICKLESS_MAX_STRETCH 8	// max # quanta a single runnable env may run before a clock interrupt
+
+uint8 kclock_tickless;			// 1 => stretch the quantum of a lone runnable env & halt when idle
+uint8 kclock_quantum;			// quantum (ms) set by the last kclock_set_quantum()
+uint8 kclock_stretch;			// # quanta covered by the current clock interval
+
+struct
+{
+	uint32 saved_ticks;			// clock interrupts avoided by stretched quanta
+	uint32 idle_halts;			// # times the CPU halted with the clock stopped
+	uint64 idle_cycles;			// TSC cycles spent halted
+} tickless_counters;
+
+void kclock_stretch_quantum(uint8 max_stretch);
+void kclock_unstretch(void);
+/********* Tickless idle & dynamic quantum *************/
+
 
 extern uint32 virtualTime;
 
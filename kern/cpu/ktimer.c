@@ -0,0 +1,176 @@
+/*2026*/
+//Kernel timers: a hierarchical timing wheel advanced by the clock interrupt
+
+#include "ktimer.h"
+#include "kclock.h"
+#include <inc/assert.h>
+#include <kern/conc/channel.h>
+
+//nobody wakes it up: its sleepers wait for their timeout only
+static struct Channel ktimer_sleep_chan;
+static struct spinlock ktimer_sleep_lock;
+
+void ktimer_init()
+{
+	for (int l = 0; l < KTIMER_LEVELS; l++)
+		for (int s = 0; s < KTIMER_WHEEL_SIZE; s++)
+			LIST_INIT(&ktimer_wheel.slots[l][s]);
+	ktimer_wheel.now = 0;
+	ktimer_wheel.pending = 0;
+	ktimer_wheel.fired = 0;
+	init_spinlock(&ktimer_wheel.lock, "timer wheel lock");
+	init_channel(&ktimer_sleep_chan, "timer sleep");
+	init_spinlock(&ktimer_sleep_lock, "timer sleep lock");
+}
+
+//Link it in its slot (the wheel must be locked). A timer due now (cascaded
+//just before the current slot is processed) goes to the current slot.
+static void ktimer_link(struct ktimer *t)
+{
+	uint32 now = ktimer_wheel.now;
+	uint32 delay = (int32)(t->expires - now) > 0 ? t->expires - now : 0;
+	if (delay > KTIMER_MAX_DELAY)
+		delay = KTIMER_MAX_DELAY;
+	uint32 at = now + delay;
+
+	int level = 0;
+	while (level < KTIMER_LEVELS - 1 && delay >= (1 << (KTIMER_WHEEL_BITS * (level + 1))))
+		level++;
+	struct ktimer_list *slot = &ktimer_wheel.slots[level][(at >> (KTIMER_WHEEL_BITS * level)) & KTIMER_WHEEL_MASK];
+	LIST_INSERT_TAIL(slot, t);
+	t->list = slot;
+}
+
+static void ktimer_unlink(struct ktimer *t)
+{
+	LIST_REMOVE(t->list, t);
+	t->list = NULL;
+}
+
+//Arm the given timer to call fn after the given # ticks (re-arm it if pending)
+void ktimer_add(struct ktimer *t, uint32 delay_ticks, void (*fn)(struct ktimer *), void *arg)
+{
+	acquire_spinlock(&ktimer_wheel.lock);
+	{
+		if (t->list != NULL)
+		{
+			ktimer_unlink(t);
+			ktimer_wheel.pending--;
+		}
+		t->fn = fn;
+		t->arg = arg;
+		t->expires = ktimer_wheel.now + (delay_ticks > 0 ? delay_ticks : 1);
+		ktimer_link(t);
+		ktimer_wheel.pending++;
+	}
+	release_spinlock(&ktimer_wheel.lock);
+}
+
+//Return 1 if it was pending (i.e. it won't fire), 0 if it already fired/never armed
+int ktimer_cancel(struct ktimer *t)
+{
+	int was_pending = 0;
+	acquire_spinlock(&ktimer_wheel.lock);
+	{
+		if (t->list != NULL)
+		{
+			ktimer_unlink(t);
+			ktimer_wheel.pending--;
+			was_pending = 1;
+		}
+	}
+	release_spinlock(&ktimer_wheel.lock);
+	return was_pending;
+}
+
+//Re-link the timers of the given slot of a higher level to the lower ones
+static void ktimer_cascade(int level)
+{
+	struct ktimer_list *slot = &ktimer_wheel.slots[level][(ktimer_wheel.now >> (KTIMER_WHEEL_BITS * level)) & KTIMER_WHEEL_MASK];
+	struct ktimer_list moved = *slot;
+	LIST_INIT(slot);
+	struct ktimer *t;
+	while ((t = LIST_FIRST(&moved)) != NULL)
+	{
+		LIST_REMOVE(&moved, t);
+		ktimer_link(t);
+	}
+}
+
+//Advance the wheel by the given # ticks (> 1 if the clock interval was stretched)
+//firing the expired timers. Called from the clock interrupt.
+void ktimer_tick(uint32 elapsed_ticks)
+{
+	acquire_spinlock(&ktimer_wheel.lock);
+	for (uint32 i = 0; i < elapsed_ticks; i++)
+	{
+		ktimer_wheel.now++;
+		if (ktimer_wheel.pending == 0)
+			continue;
+
+		uint32 now = ktimer_wheel.now;
+		for (int level = 1; level < KTIMER_LEVELS; level++)
+		{
+			if ((now & ((1 << (KTIMER_WHEEL_BITS * level)) - 1)) != 0)
+				break;
+			ktimer_cascade(level);
+		}
+
+		struct ktimer_list *slot = &ktimer_wheel.slots[0][now & KTIMER_WHEEL_MASK];
+		struct ktimer *t;
+		while ((t = LIST_FIRST(slot)) != NULL)
+		{
+			ktimer_unlink(t);
+			ktimer_wheel.pending--;
+			//a too far one is re-linked till it's really due
+			if ((int32)(t->expires - now) > 0)
+			{
+				ktimer_link(t);
+				ktimer_wheel.pending++;
+				continue;
+			}
+			ktimer_wheel.fired++;
+			t->fn(t);
+		}
+	}
+	release_spinlock(&ktimer_wheel.lock);
+}
+
+//# ticks till the next timer expires (a lower bound if it's in a higher level),
+//KTIMER_NONE if none. Used to arm the clock when it would be stopped/stretched.
+uint32 ktimer_ticks_to_next()
+{
+	uint32 ticks = KTIMER_NONE;
+	acquire_spinlock(&ktimer_wheel.lock);
+	if (ktimer_wheel.pending > 0)
+	{
+		uint32 now = ktimer_wheel.now;
+		//till the end of the current level-0 round (a cascade may bring earlier ones)
+		uint32 to_wrap = KTIMER_WHEEL_SIZE - (now & KTIMER_WHEEL_MASK);
+		ticks = to_wrap;
+		for (uint32 d = 1; d < to_wrap; d++)
+		{
+			if (!LIST_EMPTY(&ktimer_wheel.slots[0][(now + d) & KTIMER_WHEEL_MASK]))
+			{
+				ticks = d;
+				break;
+			}
+		}
+	}
+	release_spinlock(&ktimer_wheel.lock);
+	return ticks;
+}
+
+uint32 ktimer_ms_to_ticks(uint32 ms)
+{
+	uint32 quantum = kclock_quantum > 0 ? kclock_quantum : 1;
+	uint32 ticks = (ms + quantum - 1) / quantum;
+	return ticks > 0 ? ticks : 1;
+}
+
+void ktimer_sleep_ms(uint32 ms)
+{
+	acquire_spinlock(&ktimer_sleep_lock);
+	sleep_timeout(&ktimer_sleep_chan, &ktimer_sleep_lock, ktimer_ms_to_ticks(ms));
+	release_spinlock(&ktimer_sleep_lock);
+}
@@ -0,0 +1,45 @@
+/*2026*/
+#ifndef FOS_KERN_KTIMER_H
+#define FOS_KERN_KTIMER_H
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/types.h>
+#include <inc/environment_definitions.h>
+#include <kern/conc/spinlock.h>
+
+/********* Kernel timers: a hierarchical timing wheel *************/
+//Time is counted in clock ticks (quanta). Level L has KTIMER_WHEEL_SIZE slots of
+//KTIMER_WHEEL_SIZE^L ticks each: a timer is linked in the slot of its expiry at
+//the lowest level covering it, and moved (cascaded) down a level each time the
+//lower level wraps around. Adding/cancelling is O(1), a tick is O(1) amortized.
+#define KTIMER_WHEEL_BITS	6
+#define KTIMER_WHEEL_SIZE	(1 << KTIMER_WHEEL_BITS)
+#define KTIMER_WHEEL_MASK	(KTIMER_WHEEL_SIZE - 1)
+#define KTIMER_LEVELS		3
+#define KTIMER_MAX_DELAY	((1 << (KTIMER_WHEEL_BITS * KTIMER_LEVELS)) - 1)	// longer ones are cascaded again
+#define KTIMER_NONE			0xFFFFFFFF
+
+struct
+{
+	struct ktimer_list slots[KTIMER_LEVELS][KTIMER_WHEEL_SIZE];
+	uint32 now;					// last tick processed
+	uint32 pending;				// # timers in the wheel
+	uint32 fired;				// # timers expired so far
+	struct spinlock lock;
+} ktimer_wheel;
+
+void ktimer_init();
+//The callback runs with the wheel locked (interrupts off): it must not add/cancel timers
+void ktimer_add(struct ktimer *t, uint32 delay_ticks, void (*fn)(struct ktimer *), void *arg);
+int ktimer_cancel(struct ktimer *t);
+void ktimer_tick(uint32 elapsed_ticks);
+uint32 ktimer_ticks_to_next();
+uint32 ktimer_ms_to_ticks(uint32 ms);
+
+//Timed sleep of the current env (blocked on the timer channel)
+void ktimer_sleep_ms(uint32 ms);
+/********* Kernel timers: a hierarchical timing wheel *************/
+
+#endif	// !FOS_KERN_KTIMER_H
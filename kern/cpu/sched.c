@@ -11,12 +11,15 @@
 #include <kern/cmd/command_prompt.h>
 #include <kern/cpu/cpu.h>
 #include <kern/cpu/picirq.h>
+#include <kern/cpu/kclock.h>
+#include <kern/cpu/ktimer.h>
 
 
 uint32 isSchedMethodRR(){return (scheduler_method == SCH_RR);}
 uint32 isSchedMethodMLFQ(){return (scheduler_method == SCH_MLFQ); }
 uint32 isSchedMethodBSD(){return(scheduler_method == SCH_BSD); }
 uint32 isSchedMethodPRIRR(){return(scheduler_method == SCH_PRIRR); }
+uint32 isSchedMethodSTRIDE(){return(scheduler_method == SCH_STRIDE); }
 
 //===================================================================================//
 //============================ SCHEDULER FUNCTIONS ==================================//
@@ -26,6 +29,7 @@ static struct Env* (*sched_next[])(void) = {
 [SCH_MLFQ]  fos_scheduler_MLFQ,
 [SCH_BSD]   fos_scheduler_BSD,
 [SCH_PRIRR]   fos_scheduler_PRIRR,
+[SCH_STRIDE]  fos_scheduler_STRIDE,
 
 };
 
@@ -40,6 +44,8 @@ void sched_init()
 
 	init_queue(&ProcessQueues.env_new_queue);
 	init_queue(&ProcessQueues.env_exit_queue);
+	ProcessQueues.num_blocked = 0;
+	pending_wakeups = NULL;
 
 	mycpu()->scheduler_status = SCH_STOPPED;
 
@@ -47,6 +53,45 @@ void sched_init()
 	init_spinlock(&ProcessQueues.qlock, "process queues lock");
 }
 
+/*2026*/
+//Tickless idle: halt the CPU with the clock stopped till the next IRQ (e.g.
+//keyboard or disk). The ready queues are checked with interrupts disabled and
+//"sti; hlt" enables them only at the halt, so a wakeup can't be missed in-between.
+static void sched_idle_wait()
+{
+	cli();
+	acquire_spinlock(&(ProcessQueues.qlock));
+	sched_drain_wakeups();
+	int any_ready = (sched_ready_first() >= 0);
+	release_spinlock(&(ProcessQueues.qlock));
+	if (any_ready)
+		return;
+
+	//2026: a sleeping env must be woken up at its timer's expiry: arm the
+	//clock for it (as far as it can be stretched) instead of stopping it
+	uint32 next_timer = ktimer_ticks_to_next();
+	if (next_timer == KTIMER_NONE)
+	{
+		if (!kclock_tickless)
+		{
+			sti();
+			return;
+		}
+		kclock_stop();
+	}
+	else
+	{
+		kclock_set_quantum(kclock_quantum);
+		if (kclock_tickless && next_timer > 1)
+			kclock_stretch_quantum(next_timer < TICKLESS_MAX_STRETCH ? next_timer : TICKLESS_MAX_STRETCH);
+		kclock_resume();
+	}
+	uint64 start = read_tsc();
+	__asm __volatile("sti; hlt");
+	tickless_counters.idle_cycles += read_tsc() - start;
+	tickless_counters.idle_halts++;
+}
+
 //=========================
 // [2] Main FOS Scheduler:
 //=========================
@@ -85,6 +130,9 @@ fos_scheduler(void)
 		//cprintf("ACQUIRED\n");
 		do
 		{
+			//2026: make the envs woken up (lock-free) since the last time ready first
+			sched_drain_wakeups();
+
 			//Get next env according to the current scheduler
 			next_env = sched_next[scheduler_method]() ;
 
@@ -95,6 +143,16 @@ fos_scheduler(void)
 			chk2(next_env) ;
 			set_cpu_proc(old_curenv) ;
 
+			//2026: a lone runnable env: no need to interrupt it every quantum just to pick it again
+			//(not for BSD, its per-tick accounting needs every tick, nor for the LRU time
+			//approx., its WS aging is done once per clock interrupt)
+			//2026: ... but not beyond the next timer expiry
+			if (next_env != NULL && kclock_tickless && !isSchedMethodBSD() && !isPageReplacmentAlgorithmLRU(PG_REP_LRU_TIME_APPROX) && sched_ready_first() < 0)
+			{
+				uint32 next_timer = ktimer_ticks_to_next();
+				kclock_stretch_quantum(next_timer < TICKLESS_MAX_STRETCH ? next_timer : TICKLESS_MAX_STRETCH);
+			}
+
 			//sched_print_all();
 
 			if(next_env != NULL)
@@ -111,6 +169,8 @@ fos_scheduler(void)
 
 				//Change its status to RUNNING
 				next_env->env_status = ENV_RUNNING;
+				next_env->env_runs++;
+				sched_account(next_env, SCHED_ACCT_RUNNING);
 
 				//Context switch to it
 				context_switch(&(c->scheduler), next_env->context);
@@ -129,6 +189,17 @@ fos_scheduler(void)
 				assert(get_cpu_proc() == c->proc);
 				int status = c->proc->env_status ;
 				assert(status != ENV_RUNNING);
+				//2026: preempted (still ready) or gave the CPU up (blocked/exited)
+				if (status == ENV_READY)
+				{
+					c->proc->nivcsw++;
+					sched_account(c->proc, SCHED_ACCT_READY);
+				}
+				else
+				{
+					c->proc->nvcsw++;
+					sched_account(c->proc, status == ENV_BLOCKED ? SCHED_ACCT_BLOCKED : SCHED_ACCT_NONE);
+				}
 				if (status == ENV_READY)
 				{
 					//OK... will be placed to the correct ready Q in the next iteration
@@ -143,18 +214,21 @@ fos_scheduler(void)
 		} while(next_env);
 
 		//2024 - check if there's any blocked process?
-		is_any_blocked = 0;
-		for (int i = 0; i < NENV; ++i)
-		{
-			if (envs[i].env_status == ENV_BLOCKED)
-			{
-				is_any_blocked = 1;
-				break;
-			}
-		}
+		//2026: kept up to date by sleep/wakeup: no need to scan all the envs
+		is_any_blocked = (ProcessQueues.num_blocked > 0);
 		release_spinlock(&ProcessQueues.qlock);  //release lock: to protect ready & blocked Qs in multi-CPU
 		//cprintf("\n[FOS_SCHEDULER] release: lock status after = %d\n", qlock.locked);
 
+		//Nothing is runnable: use the idle time to pre-zero some free frames,
+		//then sleep (with the clock stopped) till an IRQ wakes up some env
+		if (is_any_blocked)
+		{
+			refill_zeroed_frames(ZEROED_FRAMES_PER_IDLE);
+			//2026: with the clock stopped, the timers need it armed to expire
+			if (kclock_tickless || ktimer_wheel.pending > 0)
+				sched_idle_wait();
+		}
+
 	} while (is_any_blocked > 0);
 
 	/*2015*///No more envs... curenv doesn't exist any more! return back to command prompt
@@ -183,7 +257,7 @@ void sched_init_RR(uint8 quantum)
 #endif
 	quantums[0] = quantum;
 	kclock_set_quantum(quantums[0]);
-	init_queue(&(ProcessQueues.env_ready_queues[0]));
+	sched_ready_reset();
 	//=========================================
 	//DON'T CHANGE THESE LINES=================
 	uint16 cnt0 = kclock_read_cnt0_latch() ; //read after write to ensure it's set to the desired value
@@ -205,9 +279,26 @@ void sched_init_MLFQ(uint8 numOfLevels, uint8 *quantumOfEachLevel)
 	//=========================================
 	//=========================================
 	//[PROJECT] MLFQ Scheduler - sched_init_MLFQ
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
+	num_of_ready_queues = numOfLevels;
+#if USE_KHEAP
+	ProcessQueues.env_ready_queues = kmalloc(num_of_ready_queues * sizeof(struct Env_Queue));
+	quantums = kmalloc(num_of_ready_queues * sizeof(uint8)) ;
+#endif
+	for (int i = 0; i < num_of_ready_queues; i++)
+	{
+		quantums[i] = quantumOfEachLevel[i];
+	}
+	sched_ready_reset();
+
+	//all envs start at the top level
+	for (int i = 0; i < NENV; i++)
+	{
+		envs[i].ready_queue = 0;
+		envs[i].mlfq_epoch = 0;
+	}
+	mlfq_last_boost = ticks;
+	mlfq_boost_epoch = 0;
+	kclock_set_quantum(quantums[0]);
 
 
 	//=========================================
@@ -221,15 +312,69 @@ void sched_init_MLFQ(uint8 numOfLevels, uint8 *quantumOfEachLevel)
 
 }
 
+/*2026*/
+static fixed_point_t bsd_decay[BSD_DECAY_HISTORY];		// recent_cpu decay coefficient of second s is at [s % BSD_DECAY_HISTORY]
+static struct Env* bsd_dirty_envs[BSD_PRI_PERIOD * NCPUS];	// envs that ran since the last priority recomputation
+static int bsd_num_dirty;
+
+//priority = PRI_MAX - (recent_cpu / 4) - (nice * 2), clamped to [PRI_MIN, PRI_MAX]
+static int bsd_priority_of(struct Env* e)
+{
+	int priority = PRI_MAX - fix_trunc(fix_unscale(e->recent_cpu, 4)) - (e->nice * 2);
+	if (priority > PRI_MAX)
+		priority = PRI_MAX;
+	if (priority < PRI_MIN)
+		priority = PRI_MIN;
+	return priority;
+}
+
+//Ready queue 0 holds the highest priority (PRI_MAX)
+static uint8 bsd_queue_of(int priority)
+{
+	return (PRI_MAX - priority) * num_of_ready_queues / (PRI_MAX - PRI_MIN + 1);
+}
+
+//c^k by repeated squaring
+static fixed_point_t bsd_fix_pow(fixed_point_t c, uint32 k)
+{
+	fixed_point_t result = fix_int(1);
+	while (k > 0)
+	{
+		if (k & 1)
+			result = fix_mul(result, c);
+		c = fix_mul(c, c);
+		k >>= 1;
+	}
+	return result;
+}
+
 //===============================
 // [5] Initialize BSD Scheduler:
 //===============================
 void sched_init_BSD(uint8 numOfLevels, uint8 quantum)
 {
 	//[PROJECT] BSD Scheduler - sched_init_BSD
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
+	sched_delete_ready_queues();
+	num_of_ready_queues = numOfLevels;
+#if USE_KHEAP
+	ProcessQueues.env_ready_queues = kmalloc(num_of_ready_queues * sizeof(struct Env_Queue));
+	quantums = kmalloc(sizeof(uint8)) ;
+#endif
+	quantums[0] = quantum;
+	kclock_set_quantum(quantums[0]);
+	sched_ready_reset();
+
+	load_avg = fix_int(0);
+	bsd_seconds = 0;
+	bsd_num_dirty = 0;
+	for (int i = 0; i < NENV; i++)
+	{
+		envs[i].recent_cpu = fix_int(0);
+		envs[i].bsd_second = 0;
+		envs[i].bsd_dirty = 0;
+		envs[i].priority = bsd_priority_of(&envs[i]);
+		envs[i].ready_queue = bsd_queue_of(envs[i].priority);
+	}
 
 
 	//=========================================
@@ -263,9 +408,7 @@ void sched_init_PRIRR(uint8 numOfPriorities, uint8 quantum, uint32 starvThresh)
 	ProcessQueues.env_ready_queues = kmalloc(num_of_ready_queues * 
 											sizeof(struct Env_Queue));
 										
-	for(int i = 0; i < num_of_ready_queues ; i++) {
-		init_queue(&(ProcessQueues.env_ready_queues[i]));	
-	}
+	sched_ready_reset();
 
 	release_spinlock(&ProcessQueues.qlock);
 	//=========================================
@@ -278,6 +421,41 @@ void sched_init_PRIRR(uint8 numOfPriorities, uint8 quantum, uint32 starvThresh)
 	//=========================================
 }
 
+/*2026*/
+//==================================
+// [6.1] Initialize STRIDE Scheduler:
+//==================================
+void sched_init_STRIDE(uint8 quantum)
+{
+	sched_delete_ready_queues();
+	//the ready envs are kept in one queue (for printing/killing) & picked from a min-heap of their pass
+	num_of_ready_queues = 1;
+#if USE_KHEAP
+	ProcessQueues.env_ready_queues = kmalloc(sizeof(struct Env_Queue));
+	quantums = kmalloc(sizeof(uint8)) ;
+#endif
+	quantums[0] = quantum;
+	kclock_set_quantum(quantums[0]);
+
+	sched_ready_reset();
+
+	stride_global_pass = 0;
+	for (int i = 0; i < NENV; i++)
+	{
+		envs[i].pass = 0;
+		envs[i].heap_index = -1;
+	}
+
+	//=========================================
+	//DON'T CHANGE THESE LINES=================
+	uint16 cnt0 = kclock_read_cnt0_latch() ; //read after write to ensure it's set to the desired value
+	cprintf("*	STRIDE scheduler with initial clock = %d\n", cnt0);
+	mycpu()->scheduler_status = SCH_STOPPED;
+	scheduler_method = SCH_STRIDE;
+	//=========================================
+	//=========================================
+}
+
 //=========================
 // [7] RR Scheduler:
 //=========================
@@ -297,11 +475,11 @@ struct Env* fos_scheduler_RR()
 	//If the curenv is still exist, then insert it again in the ready queue
 	if (cur_env != NULL)
 	{
-		enqueue(&(ProcessQueues.env_ready_queues[0]), cur_env);
+		sched_ready_enqueue(0, cur_env);
 	}
 
 	//Pick the next environment from the ready queue
-	next_env = dequeue(&(ProcessQueues.env_ready_queues[0]));
+	next_env = sched_ready_dequeue(0);
 
 	//Reset the quantum
 	//2017: Reset the value of CNT0 for the next clock interval
@@ -325,10 +503,61 @@ struct Env* fos_scheduler_MLFQ()
 	/****************************************************************************************/
 
 	//[PROJECT] MLFQ Scheduler - fos_scheduler_MLFQ
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
+	struct Env *next_env = NULL;
+	struct Env *cur_env = get_cpu_proc();
+
+	//Periodic boost: move every env back to the top level to avoid starvation
+	if (ticks - mlfq_last_boost >= MLFQ_BOOST_PERIOD)
+	{
+		sched_boost_MLFQ();
+		mlfq_last_boost = ticks;
+	}
+
+	//The curenv (if any) used its whole quantum: demote it one level
+	//(an env that blocks before its quantum expires isn't here, it keeps its level)
+	//If a boost happened while it's running, it's reset to the top level on insert
+	if (cur_env != NULL)
+	{
+		if (cur_env->ready_queue < num_of_ready_queues - 1)
+			cur_env->ready_queue++;
+		sched_insert_ready(cur_env);
+	}
 
+	//Pick from the highest non-empty level & give it the quantum of that level
+	int level = sched_ready_first();
+	if (level >= 0)
+	{
+		next_env = sched_ready_dequeue(level);
+		sched_catch_up_MLFQ(next_env);
+		kclock_set_quantum(quantums[level]);
+	}
+	return next_env;
+}
+
+//Move all ready envs to the top level (FIFO order of each level is kept, lower
+//levels queued behind upper ones). Only the ready queues are walked: the
+//blocked/running envs are reset lazily by sched_catch_up_MLFQ()
+void sched_boost_MLFQ()
+{
+	mlfq_boost_epoch++;
+	for (int level = 1; level < num_of_ready_queues; level++)
+	{
+		struct Env *env;
+		while ((env = sched_ready_dequeue(level)) != NULL)
+		{
+			sched_ready_enqueue(0, env);
+		}
+	}
+}
+
+//An env that missed a boost (blocked, running or ready at that time) is at the
+//top level since then: reset its level before it's queued or run
+void sched_catch_up_MLFQ(struct Env* e)
+{
+	if (e->mlfq_epoch == mlfq_boost_epoch)
+		return;
+	e->ready_queue = 0;
+	e->mlfq_epoch = mlfq_boost_epoch;
 }
 
 //=========================
@@ -342,11 +571,196 @@ struct Env* fos_scheduler_BSD()
 	/****************************************************************************************/
 
 	//[PROJECT] BSD Scheduler - fos_scheduler_BSD
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
+	struct Env *next_env = NULL;
+	struct Env *cur_env = get_cpu_proc();
+
+	//The curenv (if any) goes back to the queue of its priority as of the last recomputation
+	if (cur_env != NULL)
+	{
+		sched_insert_ready(cur_env);
+	}
+
+	//Pick from the highest non-empty priority queue
+	int queue = sched_ready_first();
+	if (queue >= 0)
+	{
+		next_env = sched_ready_dequeue(queue);
+	}
+	kclock_set_quantum(quantums[0]);
+	return next_env;
+}
+
+//Recompute the priority of the given env and move it to the queue of the new
+//priority if it's READY and that queue changed (qlock must be held)
+void env_update_priority_BSD(struct Env* e)
+{
+	e->priority = bsd_priority_of(e);
+	uint8 queue = bsd_queue_of(e->priority);
+	if (e->env_status == ENV_READY && queue != e->ready_queue)
+	{
+		sched_ready_unlink(e);
+		sched_ready_enqueue(queue, e);
+	}
+	else
+	{
+		e->ready_queue = queue;
+	}
+}
+
+//Apply the recent_cpu decays of the seconds passed since the given env was
+//last decayed, then recompute its priority (qlock must be held):
+//	recent_cpu = (2*load_avg)/(2*load_avg + 1) * recent_cpu + nice
+//An env that's blocked or new is not visited every second: it catches up
+//here when it becomes ready again.
+void sched_catch_up_BSD(struct Env* e)
+{
+	uint32 missed = bsd_seconds - e->bsd_second;
+	if (missed == 0)
+		return;
+
+	if (missed > BSD_DECAY_HISTORY)
+	{
+		//Coefficients older than the kept history are gone: apply the oldest
+		//kept one for the extra seconds in closed form
+		//	recent_cpu = c^k * recent_cpu + nice * (1 - c^k) / (1 - c)
+		uint32 k = missed - BSD_DECAY_HISTORY;
+		fixed_point_t c = bsd_decay[(bsd_seconds + 1) % BSD_DECAY_HISTORY];
+		fixed_point_t ck = bsd_fix_pow(c, k);
+		fixed_point_t one = fix_int(1);
+		e->recent_cpu = fix_add(fix_mul(ck, e->recent_cpu),
+				fix_mul(fix_int(e->nice), fix_div(fix_sub(one, ck), fix_sub(one, c))));
+		missed = BSD_DECAY_HISTORY;
+	}
+	for (uint32 s = bsd_seconds - missed + 1; missed > 0; s++, missed--)
+	{
+		e->recent_cpu = fix_add(fix_mul(bsd_decay[s % BSD_DECAY_HISTORY], e->recent_cpu), fix_int(e->nice));
+	}
+	e->bsd_second = bsd_seconds;
+	env_update_priority_BSD(e);
+}
+
+//Per-tick bookkeeping of the BSD scheduler (qlock must be held).
+//Only the envs whose recent_cpu changed are visited: the running one every
+//tick, the ready ones once per second. Blocked ones catch up lazily.
+void sched_tick_BSD(struct Env* cur_env)
+{
+	//this is called before ticks is incremented for the current tick
+	int64 now = ticks + 1;
+
+	//1) The running env consumed this tick
+	if (cur_env != NULL)
+	{
+		cur_env->recent_cpu = fix_add(cur_env->recent_cpu, fix_int(1));
+		if (!cur_env->bsd_dirty && bsd_num_dirty < BSD_PRI_PERIOD * NCPUS)
+		{
+			cur_env->bsd_dirty = 1;
+			bsd_dirty_envs[bsd_num_dirty++] = cur_env;
+		}
+	}
+
+	//2) Once per second: update load_avg & decay the recent_cpu of the ready envs
+	int ticks_per_sec = 1000 / quantums[0];
+	if (ticks_per_sec == 0)
+		ticks_per_sec = 1;
+	if (now % ticks_per_sec == 0)
+	{
+		int num_ready = (cur_env != NULL) ? 1 : 0;
+		uint32 bitmap[MAX_READY_QUEUES/32];
+		for (int w = 0; w < MAX_READY_QUEUES/32; w++)
+		{
+			bitmap[w] = ProcessQueues.ready_bitmap[w];
+			uint32 bits = bitmap[w];
+			while (bits != 0)
+			{
+				num_ready += LIST_SIZE(&ProcessQueues.env_ready_queues[w * 32 + bit_scan_forward(bits)]);
+				bits &= bits - 1;
+			}
+		}
+		//load_avg = (59/60) * load_avg + (1/60) * ready_envs
+		load_avg = fix_add(fix_mul(fix_frac(59, 60), load_avg), fix_unscale(fix_int(num_ready), 60));
 
+		fixed_point_t twice_load = fix_scale(load_avg, 2);
+		bsd_seconds++;
+		bsd_decay[bsd_seconds % BSD_DECAY_HISTORY] = fix_div(twice_load, fix_add(twice_load, fix_int(1)));
+
+		if (cur_env != NULL)
+			sched_catch_up_BSD(cur_env);
+		//an env moved to a queue that's not visited yet is visited again: no-op
+		for (int w = 0; w < MAX_READY_QUEUES/32; w++)
+		{
+			while (bitmap[w] != 0)
+			{
+				int queue = w * 32 + bit_scan_forward(bitmap[w]);
+				bitmap[w] &= bitmap[w] - 1;
+				struct Env *env;
+				LIST_FOREACH(env, &ProcessQueues.env_ready_queues[queue])
+				{
+					sched_catch_up_BSD(env);
+				}
+			}
+		}
+	}
+
+	//3) Every BSD_PRI_PERIOD ticks: recompute the priority of the envs that ran since the last time
+	if (now % BSD_PRI_PERIOD == 0)
+	{
+		for (int i = 0; i < bsd_num_dirty; i++)
+		{
+			struct Env *e = bsd_dirty_envs[i];
+			e->bsd_dirty = 0;
+			if (e->env_status != ENV_FREE)
+				env_update_priority_BSD(e);
+		}
+		bsd_num_dirty = 0;
+	}
+}
+//Promote each env that waited more than starvation_threshold ticks in the
+//ready queues since its last promotion by one level. Its age accumulates
+//over all its waits as the former per-tick age counter did, and it's promoted
+//at the same tick (see sched_starvation_due).
+//Only the non-empty queues are visited, and a queue is walked only once its
+//lower bound of the due ticks has passed (the bound is then recomputed).
+static void sched_promote_starved_PRIRR()
+{
+	uint32 now = (uint32)ticks;
+	for (int w = 0; w < MAX_READY_QUEUES/32; w++)
+	{
+		uint32 bits = ProcessQueues.ready_bitmap[w];
+		while (bits != 0)
+		{
+			int priority = w * 32 + bit_scan_forward(bits);
+			bits &= bits - 1;
+			// Start from priority = 1 since if I promote in priority 0 it will fly
+			if (priority == 0 || (int32)(now - prirr_queue_due[priority]) <= 0)
+				continue;
+
+			int any_left = 0;
+			uint32 next_due = 0;
+			struct Env *env = LIST_FIRST(&ProcessQueues.env_ready_queues[priority]);
+			while (env != NULL)
+			{
+				struct Env *next = LIST_NEXT(env);
+				uint32 due = sched_starvation_due(env);
+				if ((int32)(now - due) > 0)
+				{
+					sched_ready_unlink(env);
+					env->age = 0;
+					env->priority = priority - 1;
+					sched_ready_enqueue(priority - 1, env);
+				}
+				else if (!any_left || (int32)(due - next_due) < 0)
+				{
+					next_due = due;
+					any_left = 1;
+				}
+				env = next;
+			}
+			if (any_left)
+				prirr_queue_due[priority] = next_due;
+		}
+	}
 }
+
 //=============================
 // [10] PRIORITY RR Scheduler:
 //=============================
@@ -368,12 +782,13 @@ struct Env* fos_scheduler_PRIRR()
 		sched_insert_ready(cur_env);
 	}
 
-	for (int priority = 0; priority < num_of_ready_queues; priority++) {
-		if(!LIST_EMPTY(&ProcessQueues.env_ready_queues[priority])) {
-			to_add = dequeue(&ProcessQueues.env_ready_queues[priority]);
-			to_add->env_status = ENV_UNKNOWN;
-			break;
-		}
+	sched_promote_starved_PRIRR();
+
+	//first non-empty priority queue from the bitmap
+	int priority = sched_ready_first();
+	if (priority >= 0) {
+		to_add = sched_ready_dequeue(priority);
+		to_add->env_status = ENV_UNKNOWN;
 	}
 
 	kclock_set_quantum(quantums[0]);
@@ -381,6 +796,39 @@ struct Env* fos_scheduler_PRIRR()
 	return to_add;
 }
 
+/*2026*/
+//=============================
+// [10.1] STRIDE Scheduler:
+//=============================
+//Proportional share: each env advances its pass by its stride (inversely
+//proportional to its tickets) for every quantum it runs, and the ready env
+//with the min pass runs next. Picking is O(log n) through the min-heap.
+struct Env* fos_scheduler_STRIDE()
+{
+	/*To protect process Qs (or info of current process) in multi-CPU************************/
+	if(!holding_spinlock(&ProcessQueues.qlock))
+		panic("fos_scheduler_STRIDE: q.lock is not held by this CPU while it's expected to be.");
+	/****************************************************************************************/
+	struct Env *next_env = NULL;
+	struct Env *cur_env = get_cpu_proc();
+
+	//The curenv (if any) is charged for the quantum it consumed
+	if (cur_env != NULL)
+	{
+		cur_env->pass += cur_env->stride;
+		sched_insert_ready(cur_env);
+	}
+
+	next_env = sched_stride_min();
+	if (next_env != NULL)
+	{
+		sched_ready_unlink(next_env);
+		stride_global_pass = next_env->pass;
+	}
+	kclock_set_quantum(quantums[0]);
+	return next_env;
+}
+
 //========================================
 // [11] Clock Interrupt Handler
 //	  (Automatically Called Every Quantum)
@@ -391,28 +839,29 @@ void clock_interrupt_handler(struct Trapframe* tf)
 	{
 		//TODO: [PROJECT'24.MS3 - #09] [3] PRIORITY RR Scheduler - clock_interrupt_handler
 		
-		struct Env *env;
-		
-		// would be better to use a sleep lock here
+		//Nothing to do per tick: the starved envs are promoted at the next pick
+		//from their enqueue time (see sched_promote_starved_PRIRR)
+	}
+	else if (isSchedMethodBSD())
+	{
 		acquire_spinlock(&ProcessQueues.qlock);
-
-		// Start from priority = 1 since if I promote in priority 0 it will fly
-		for (int priority = 1; priority < num_of_ready_queues; priority++) {
-			LIST_FOREACH(env, &ProcessQueues.env_ready_queues[priority])
-			{
-				if (env->age > starvation_threshold) {
-					env_set_priority(env->env_id, priority - 1);
-					env->age = 0;
-				}
-				else {
-					env->age++;
-				}
-			}
-		}
-
+		sched_tick_BSD(get_cpu_proc());
 		release_spinlock(&ProcessQueues.qlock);
 	}
 
+	//2026: a stretched clock interval covers several quanta
+	uint32 elapsed_ticks = 1;
+	if (kclock_stretch > 1)
+	{
+		tickless_counters.saved_ticks += kclock_stretch - 1;
+		ticks += kclock_stretch - 1;
+		elapsed_ticks = kclock_stretch;
+	}
+
+	//2026: expire the timers (before yield(): the envs they wake up must not
+	//wait for the current env to run again)
+	ktimer_tick(elapsed_ticks);
+
 
 
 	/********DON'T CHANGE THESE LINES***********/
@@ -449,6 +898,28 @@ void update_WS_time_stamps()
 		{
 			int i ;
 #if USE_KHEAP
+			if (curr_env_ptr->page_WS_array != NULL)
+			{
+				//2026: compact WS array: one linear sweep
+				struct WSArrayEntry *ws = curr_env_ptr->page_WS_array;
+				for (i = 0 ; i < (curr_env_ptr->page_WS_max_size); i++)
+				{
+					if (!WSA_IS_VALID(&ws[i]))
+						continue;
+					uint32 page_va = WSA_VA(&ws[i]);
+					uint32 perm = pt_get_page_permissions(curr_env_ptr->env_page_directory, page_va) ;
+					if (perm & PERM_USED)
+					{
+						ws[i].time_stamp = (ws[i].time_stamp>>2) | 0x80000000;
+						pt_set_page_permissions(curr_env_ptr->env_page_directory, page_va, 0 , PERM_USED) ;
+					}
+					else
+					{
+						ws[i].time_stamp = (ws[i].time_stamp>>2);
+					}
+				}
+			}
+			else
 			LIST_FOREACH(wse, &(curr_env_ptr->page_WS_list))
 			{
 #else
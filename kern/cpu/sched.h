@@ -16,6 +16,9 @@
 #define SCH_MLFQ 	1
 #define SCH_BSD 	2
 #define SCH_PRIRR 	3
+#define SCH_STRIDE 	4
+
+#define MAX_READY_QUEUES 256	// num_of_ready_queues is an uint8
 
 //2024 - decide whether to place this as a private member for each CPU or as a global for all CPUs?
 unsigned scheduler_method ;
@@ -33,8 +36,17 @@ struct
 	//RR ONLY
 	struct Env_Queue env_ready_queues[1];// Ready queue(s) for the RR
 #endif
+	uint32 ready_bitmap[MAX_READY_QUEUES/32];	// 2026: bit i is set <=> env_ready_queues[i] is not empty
+	uint32 num_blocked;					// 2026: # envs blocked on channels & user semaphores (incl. woken up, not drained yet)
 }ProcessQueues;
 
+//2026: ready-queue waits of all envs per ready queue (i.e. per priority/level), same buckets as Env.sched_wait_hist
+uint32 sched_queue_wait_hist[MAX_READY_QUEUES][SCHED_HIST_BUCKETS];
+
+//2026: envs woken up without the qlock (LIFO, linked by wake_next): pushed lock-free
+//by the wakeups & moved to the ready queues by the scheduler (the only consumer)
+struct Env * volatile pending_wakeups;
+
 #if USE_KHEAP
 	uint8 *quantums ;					// Quantum(s) in ms for each level of the ready queue(s)
 #else
@@ -43,6 +55,24 @@ struct
 #endif
 	uint8 num_of_ready_queues ;			// Number of ready queue(s)
 	uint32 starvation_threshold;
+	//2026: PRIRR: per ready queue, a lower bound of the ticks after which its envs get starved
+	uint32 prirr_queue_due[MAX_READY_QUEUES];
+
+/*2026*/
+/********* for MLFQ Scheduler *************/
+#define MLFQ_BOOST_PERIOD 100			// # clock ticks between two boosts of all envs to the top level
+int64 mlfq_last_boost;
+uint32 mlfq_boost_epoch;				// # boosts so far: an env that missed some is reset to the top level when it's made ready again
+void sched_catch_up_MLFQ(struct Env* e);
+/********* for MLFQ Scheduler *************/
+
+/*2026*/
+/********* for Stride Scheduler *************/
+#define STRIDE1 (1 << 20)				// stride of an env with a single ticket
+#define STRIDE_DEFAULT_TICKETS 100
+#define STRIDE_MAX_TICKETS 10000
+uint32 stride_global_pass;				// pass of the last picked env: a joining env can't start behind it
+/********* for Stride Scheduler *************/
 
 //===============
 
@@ -62,22 +92,35 @@ struct
 #define PRI_MAX 63
 int64 ticks;
 int64 timer_ticks() ;
+
+/*2026*/
+#define BSD_PRI_PERIOD 4				// # ticks between two priority recomputations
+#define BSD_DECAY_HISTORY 64			// # seconds of recent_cpu decay coefficients kept for the lazy catch-up
+fixed_point_t load_avg;
+uint32 bsd_seconds;						// # seconds elapsed since the BSD scheduler is initialized
+void sched_tick_BSD(struct Env* cur_env);
+void sched_catch_up_BSD(struct Env* e);
+void env_update_priority_BSD(struct Env* e);
 /********* for BSD Priority Scheduler *************/
 
 void sched_init_RR(uint8 quantum);
 void sched_init_MLFQ(uint8 numOfLevels, uint8 *quantumOfEachLevel);
 void sched_init_BSD(uint8 numOfLevels, uint8 quantum);
 void sched_init_PRIRR(uint8 numOfPriorities, uint8 quantum, uint32 starvThresh);
+void sched_init_STRIDE(uint8 quantum);
 
 uint32 isSchedMethodRR();
 uint32 isSchedMethodMLFQ();
 uint32 isSchedMethodBSD();
 uint32 isSchedMethodPRIRR();
+uint32 isSchedMethodSTRIDE();
 
 struct Env* fos_scheduler_RR();
 struct Env* fos_scheduler_MLFQ();
 struct Env* fos_scheduler_BSD();
 struct Env* fos_scheduler_PRIRR();
+struct Env* fos_scheduler_STRIDE();
+void sched_boost_MLFQ();
 
 //2012
 // This function does not return.
@@ -9,6 +9,8 @@
 #include <kern/tests/utilities.h>
 #include <kern/cmd/command_prompt.h>
 #include <kern/cpu/cpu.h>
+#include <kern/cpu/kclock.h>
+#include <kern/conc/channel.h>
 
 //void on_clock_update_WS_time_stamps();
 extern void cleanup_buffers(struct Env* e);
@@ -101,6 +103,328 @@ struct Env* find_env_in_queue(struct Env_Queue* queue, uint32 envID)
 	return NULL;
 }
 
+//=====================================================================================//
+//============================= STRIDE MIN-HEAP OF PASS ===============================//
+//=====================================================================================//
+//Under the STRIDE scheduler, every ready env is also kept in this binary
+//min-heap keyed by its pass (compared modulo 2^32, so the pass may wrap).
+static struct Env* stride_heap[NENV];
+static int stride_heap_size;
+
+static inline int stride_before(struct Env* a, struct Env* b)
+{
+	return (int32)(a->pass - b->pass) < 0;
+}
+
+static inline void stride_heap_set(int index, struct Env* env)
+{
+	stride_heap[index] = env;
+	env->heap_index = index;
+}
+
+static void stride_heap_sift_up(int index)
+{
+	struct Env* env = stride_heap[index];
+	while (index > 0 && stride_before(env, stride_heap[(index - 1) / 2]))
+	{
+		stride_heap_set(index, stride_heap[(index - 1) / 2]);
+		index = (index - 1) / 2;
+	}
+	stride_heap_set(index, env);
+}
+
+static void stride_heap_sift_down(int index)
+{
+	struct Env* env = stride_heap[index];
+	while (1)
+	{
+		int child = 2 * index + 1;
+		if (child >= stride_heap_size)
+			break;
+		if (child + 1 < stride_heap_size && stride_before(stride_heap[child + 1], stride_heap[child]))
+			child++;
+		if (!stride_before(stride_heap[child], env))
+			break;
+		stride_heap_set(index, stride_heap[child]);
+		index = child;
+	}
+	stride_heap_set(index, env);
+}
+
+static void stride_heap_push(struct Env* env)
+{
+	stride_heap_set(stride_heap_size++, env);
+	stride_heap_sift_up(env->heap_index);
+}
+
+static void stride_heap_remove(struct Env* env)
+{
+	int index = env->heap_index;
+	if (index < 0)
+		return;
+	env->heap_index = -1;
+	struct Env* last = stride_heap[--stride_heap_size];
+	if (index == stride_heap_size)
+		return;
+	stride_heap_set(index, last);
+	stride_heap_sift_down(index);
+	stride_heap_sift_up(last->heap_index);
+}
+
+//The ready env with the min pass (or NULL)
+struct Env* sched_stride_min(void)
+{
+	return stride_heap_size > 0 ? stride_heap[0] : NULL;
+}
+
+//=====================================================================================//
+//=========================== READY Q'S (PRIORITY BITMAP) =============================//
+//=====================================================================================//
+//All the ready queues are manipulated through these functions to keep the
+//non-empty bitmap in sync, so that picking the first non-empty queue and
+//removing a ready env are O(1) whatever the # of queues and envs is.
+
+//=================================
+// [1] Empty all the ready queues:
+//=================================
+void sched_ready_reset(void)
+{
+	for (int i = 0; i < num_of_ready_queues; i++)
+		init_queue(&(ProcessQueues.env_ready_queues[i]));
+	memset(ProcessQueues.ready_bitmap, 0, sizeof(ProcessQueues.ready_bitmap));
+	stride_heap_size = 0;
+	memset(sched_queue_wait_hist, 0, sizeof(sched_queue_wait_hist));	//the queues may mean other priorities now
+}
+
+//==========================================
+// [2] Enqueue env in the given ready queue:
+//==========================================
+void sched_ready_enqueue(uint8 queue_index, struct Env* env)
+{
+	if (env == NULL)
+		return;
+	enqueue(&(ProcessQueues.env_ready_queues[queue_index]), env);
+	env->ready_queue = queue_index;
+	env->ready_since = (uint32)ticks;
+	ProcessQueues.ready_bitmap[queue_index / 32] |= (1 << (queue_index % 32));
+	if (isSchedMethodPRIRR() && queue_index > 0)
+	{
+		uint32 due = sched_starvation_due(env);
+		if (LIST_SIZE(&(ProcessQueues.env_ready_queues[queue_index])) == 1 || (int32)(due - prirr_queue_due[queue_index]) < 0)
+			prirr_queue_due[queue_index] = due;
+	}
+	if (isSchedMethodSTRIDE())
+		stride_heap_push(env);
+}
+
+//============================================
+// [3] Dequeue env from the given ready queue:
+//============================================
+struct Env* sched_ready_dequeue(uint8 queue_index)
+{
+	struct Env_Queue *queue = &(ProcessQueues.env_ready_queues[queue_index]);
+	struct Env* env = dequeue(queue);
+	if (LIST_EMPTY(queue))
+		ProcessQueues.ready_bitmap[queue_index / 32] &= ~(1 << (queue_index % 32));
+	if (env != NULL && isSchedMethodPRIRR() && queue_index > 0)
+		env->age += (uint32)ticks - env->ready_since;
+	if (env != NULL && isSchedMethodSTRIDE())
+		stride_heap_remove(env);
+	return env;
+}
+
+//=====================================================
+// [4] Unlink the given env from the ready queue it's in:
+//=====================================================
+void sched_ready_unlink(struct Env* env)
+{
+	uint8 queue_index = env->ready_queue;
+	struct Env_Queue *queue = &(ProcessQueues.env_ready_queues[queue_index]);
+	remove_from_queue(queue, env);
+	if (LIST_EMPTY(queue))
+		ProcessQueues.ready_bitmap[queue_index / 32] &= ~(1 << (queue_index % 32));
+	if (isSchedMethodPRIRR() && queue_index > 0)
+		env->age += (uint32)ticks - env->ready_since;
+	if (isSchedMethodSTRIDE())
+		stride_heap_remove(env);
+}
+
+//2026: PRIRR: tick after which the given ready env is starved, i.e. when the
+//ticks it waited in the ready queues (priority >= 1) since its last promotion
+//pass starvation_threshold + 1 (the tick at which the former per-tick age
+//counter passed the threshold)
+uint32 sched_starvation_due(struct Env* env)
+{
+	return env->ready_since + starvation_threshold + 1 - env->age;
+}
+
+//=======================================================
+// [5] Index of the first non-empty ready queue (or -1):
+//=======================================================
+int sched_ready_first(void)
+{
+	for (int w = 0; w < MAX_READY_QUEUES/32; w++)
+	{
+		if (ProcessQueues.ready_bitmap[w] != 0)
+			return w * 32 + bit_scan_forward(ProcessQueues.ready_bitmap[w]);
+	}
+	return -1;
+}
+
+//=====================================================================================//
+//=============================== SCHED ACCOUNTING ====================================//
+//=====================================================================================//
+//The time of each env is split between ready, running & blocked using the TSC.
+//Each ready wait is also counted in a log2 histogram of the env & of the ready
+//queue it waited in.
+
+static int sched_hist_bucket(uint64 cycles)
+{
+	int b = 0;
+	cycles >>= 11;
+	while (cycles != 0 && b < SCHED_HIST_BUCKETS - 1)
+	{
+		cycles >>= 1;
+		b++;
+	}
+	return b;
+}
+
+//==========================================================
+// [1] Account the time since its last change & move it to
+//     the given state (SCHED_ACCT_xxx):
+//==========================================================
+void sched_account(struct Env* env, uint8 new_state)
+{
+	uint64 now = read_tsc();
+	uint64 elapsed = now - env->sched_state_since;
+	switch (env->sched_state)
+	{
+	case SCHED_ACCT_READY:
+	{
+		env->sched_ready_time += elapsed;
+		if (elapsed > env->sched_max_ready_wait)
+			env->sched_max_ready_wait = elapsed;
+		int b = sched_hist_bucket(elapsed);
+		env->sched_wait_hist[b]++;
+		sched_queue_wait_hist[env->ready_queue][b]++;
+		break;
+	}
+	case SCHED_ACCT_RUNNING:
+		env->sched_run_time += elapsed;
+		break;
+	case SCHED_ACCT_BLOCKED:
+		env->sched_blocked_time += elapsed;
+		break;
+	}
+	env->sched_state = new_state;
+	env->sched_state_since = now;
+}
+
+static void sched_print_hist(uint32 *hist)
+{
+	for (int b = 0; b < SCHED_HIST_BUCKETS; b++)
+	{
+		if (hist[b] != 0)
+			cprintf("		%s2^%d cycles: %d\n", b == SCHED_HIST_BUCKETS - 1 ? ">=" : "< ", b + 11, hist[b]);
+	}
+}
+
+//====================================================
+// [2] Print the accounting of all envs & ready queues:
+//====================================================
+void sched_print_stats(void)
+{
+	acquire_spinlock(&ProcessQueues.qlock);
+	{
+		cprintf("Per env (times in Kcycles):\n");
+		for (int i = 0; i < NENV; i++)
+		{
+			struct Env *e = &envs[i];
+			if (e->env_status == ENV_FREE)
+				continue;
+			cprintf("[%d] %s: runs = %d, run = %llu, ready = %llu (max wait = %llu), blocked = %llu, vol/invol switches = %d/%d\n",
+					e->env_id, e->prog_name, e->env_runs, e->sched_run_time >> 10, e->sched_ready_time >> 10,
+					e->sched_max_ready_wait >> 10, e->sched_blocked_time >> 10, e->nvcsw, e->nivcsw);
+			sched_print_hist(e->sched_wait_hist);
+		}
+		cprintf("Per ready queue (priority/level):\n");
+		for (int q = 0; q < num_of_ready_queues; q++)
+		{
+			uint32 total = 0;
+			for (int b = 0; b < SCHED_HIST_BUCKETS; b++)
+				total += sched_queue_wait_hist[q][b];
+			if (total == 0)
+				continue;
+			cprintf("	queue #%d: %d waits\n", q, total);
+			sched_print_hist(sched_queue_wait_hist[q]);
+		}
+	}
+	release_spinlock(&ProcessQueues.qlock);
+}
+
+//=====================================================================================//
+//=============================== LOCK-FREE WAKEUPS ===================================//
+//=====================================================================================//
+//A wakeup only pushes the env to pending_wakeups (multi-producer, no lock), so it
+//never contends with the dispatching. The scheduler is the single consumer: it
+//takes the whole list at once under the qlock, so there's no ABA problem.
+
+//=================================================
+// [1] Push a woken up env (any context, no lock):
+//=================================================
+void sched_wakeup_lockfree(struct Env* env)
+{
+	struct Env *head;
+	do
+	{
+		head = pending_wakeups;
+		env->wake_next = head;
+	} while (cmpxchg((volatile uint32 *)&pending_wakeups, (uint32)head, (uint32)env) != (uint32)head);
+
+	//the running env (if any) is no longer alone: back to a normal quantum
+	kclock_unstretch();
+}
+
+//=========================================================
+// [2] Move the woken up envs to the ready queues (qlock):
+//=========================================================
+void sched_drain_wakeups(void)
+{
+	/*To protect process Qs (or info of current process) in multi-CPU*/
+	if(!holding_spinlock(&ProcessQueues.qlock))
+		panic("sched: q.lock is not held by this CPU while it's expected to be.");
+	/*********************************************************************/
+	if (pending_wakeups == NULL)
+		return;
+
+	struct Env *list = (struct Env *)xchg((volatile uint32 *)&pending_wakeups, 0);
+
+	//reverse it to make them ready in the order they're woken up
+	struct Env *fifo = NULL;
+	while (list != NULL)
+	{
+		struct Env *next = list->wake_next;
+		list->wake_next = fifo;
+		fifo = list;
+		list = next;
+	}
+	while (fifo != NULL)
+	{
+		struct Env *env = fifo;
+		fifo = env->wake_next;
+		env->wake_next = NULL;
+
+		ProcessQueues.num_blocked--;
+		if (env->blocked_chan != NULL)
+		{
+			chan_unlink_if_empty((struct Channel *)env->blocked_chan);
+			env->blocked_chan = NULL;
+		}
+		sched_insert_ready(env);
+	}
+}
+
 //=====================================================================================//
 //============================== SCHED Q'S FUNCTIONS ==================================//
 //=====================================================================================//
@@ -137,7 +461,7 @@ void sched_insert_ready0(struct Env* env)
 	{
 		//cprintf("\nInserting %d into ready queue 0\n", env->env_id);
 		env->env_status = ENV_READY ;
-		enqueue(&(ProcessQueues.env_ready_queues[0]), env);
+		sched_ready_enqueue(0, env);
 	}
 }
 
@@ -154,8 +478,34 @@ void sched_insert_ready(struct Env* env)
 	assert(env != NULL);
 	{
 		//cprintf("\nInserting %d into ready queue 0\n", env->env_id);
+		//new/woken up: its ready wait starts now (a preempted one is already accounted as ready)
+		if (env->sched_state != SCHED_ACCT_READY)
+			sched_account(env, SCHED_ACCT_READY);
+		//BSD: apply the recent_cpu decays it missed while it was blocked
+		if (isSchedMethodBSD())
+			sched_catch_up_BSD(env);
+		//MLFQ: back to the top level if it missed a boost
+		else if (isSchedMethodMLFQ())
+			sched_catch_up_MLFQ(env);
 		env->env_status = ENV_READY ;
-		enqueue(&(ProcessQueues.env_ready_queues[env->priority]), env);
+		//MLFQ: keep the level it reached (e.g. when it's woken up after blocking early)
+		//BSD: the queue of its priority
+		if (isSchedMethodMLFQ() || isSchedMethodBSD())
+			sched_ready_enqueue(env->ready_queue, env);
+		//RR: its only queue
+		else if (isSchedMethodRR())
+			sched_ready_enqueue(0, env);
+		else if (isSchedMethodSTRIDE())
+		{
+			//STRIDE: an env that was blocked/new can't claim the CPU time it didn't compete for
+			if ((int32)(env->pass - stride_global_pass) < 0)
+				env->pass = stride_global_pass;
+			sched_ready_enqueue(0, env);
+		}
+		else
+			sched_ready_enqueue(env->priority, env);
+		//2026: the running env (if any) is no longer alone: back to a normal quantum
+		kclock_unstretch();
 	}
 }
 
@@ -171,16 +521,9 @@ void sched_remove_ready(struct Env* env)
 
 	assert(env != NULL && env->env_status == ENV_READY);
 	{
-		for (int i = 0 ; i < num_of_ready_queues ; i++)
-		{
-			struct Env * ptr_env = find_env_in_queue(&(ProcessQueues.env_ready_queues[i]), env->env_id);
-			if (ptr_env != NULL)
-			{
-				LIST_REMOVE(&(ProcessQueues.env_ready_queues[i]), env);
-				env->env_status = ENV_UNKNOWN;
-				return ;
-			}
-		}
+		//the env is linked in the queue it was inserted in: no need to search for it
+		sched_ready_unlink(env);
+		env->env_status = ENV_UNKNOWN;
 	}
 }
 
@@ -314,6 +657,8 @@ void sched_exit_env(uint32 envId)
 	{
 		acquire_spinlock(&ProcessQueues.qlock);
 	}
+	//2026: a woken up env is in no queue till it's drained
+	sched_drain_wakeups();
 	struct Env* ptr_env=NULL;
 	int found = 0;
 	if (!found)
@@ -339,7 +684,7 @@ void sched_exit_env(uint32 envId)
 				{
 					if(ptr_env->env_id == envId)
 					{
-						LIST_REMOVE(&(ProcessQueues.env_ready_queues[i]), ptr_env);
+						sched_ready_unlink(ptr_env);
 						found = 1;
 						break;
 					}
@@ -389,6 +734,8 @@ void sched_exit_env(uint32 envId)
 void sched_kill_env(uint32 envId)
 {
 	acquire_spinlock(&(ProcessQueues.qlock)); 	//CS on Qs
+	//2026: a woken up env is in no queue till it's drained
+	sched_drain_wakeups();
 	struct Env* ptr_env=NULL;
 	int found = 0;
 	if (!found)
@@ -416,7 +763,7 @@ void sched_kill_env(uint32 envId)
 					if(ptr_env->env_id == envId)
 					{
 						cprintf("killing[%d] %s from the READY queue #%d...", ptr_env->env_id, ptr_env->prog_name, i);
-						LIST_REMOVE(&(ProcessQueues.env_ready_queues[i]), ptr_env);
+						sched_ready_unlink(ptr_env);
 						found = 1;
 						break;
 					}
@@ -557,6 +904,8 @@ void sched_run_all()
 void sched_kill_all()
 {
 	acquire_spinlock(&(ProcessQueues.qlock)); 	//CS on Qs
+	//2026: a woken up env is in no queue till it's drained
+	sched_drain_wakeups();
 	struct Env* ptr_env ;
 	if (!LIST_EMPTY(&ProcessQueues.env_new_queue))
 	{
@@ -582,7 +931,7 @@ void sched_kill_all()
 			LIST_FOREACH(ptr_env, &(ProcessQueues.env_ready_queues[i]))
 			{
 				cprintf("	killing[%d] %s...", ptr_env->env_id, ptr_env->prog_name);
-				LIST_REMOVE(&(ProcessQueues.env_ready_queues[i]), ptr_env);
+				sched_ready_unlink(ptr_env);
 				env_free(ptr_env);
 				cprintf("DONE\n");
 			}
@@ -648,7 +997,7 @@ void sched_exit_all_ready_envs()
 			ptr_env=NULL;
 			LIST_FOREACH(ptr_env, &(ProcessQueues.env_ready_queues[i]))
 			{
-				LIST_REMOVE(&(ProcessQueues.env_ready_queues[i]), ptr_env);
+				sched_ready_unlink(ptr_env);
 				sched_insert_exit(ptr_env);
 			}
 		}
@@ -665,34 +1014,41 @@ int64 timer_ticks()
 int env_get_nice(struct Env* e)
 {
 	//[PROJECT] BSD Scheduler - env_get_nice
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
+	return e->nice;
 }
 
 void env_set_nice(struct Env* e, int nice_value)
 {
 	//[PROJECT] BSD Scheduler - env_set_nice
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
+	if (nice_value > 20)
+		nice_value = 20;
+	if (nice_value < -20)
+		nice_value = -20;
+
+	bool lock_already_held = holding_spinlock(&ProcessQueues.qlock);
+	if (!lock_already_held)
+		acquire_spinlock(&(ProcessQueues.qlock)); 	//CS on Qs
+	{
+		e->nice = nice_value;
+		if (isSchedMethodBSD())
+			env_update_priority_BSD(e);
+	}
+	if (!lock_already_held)
+		release_spinlock(&(ProcessQueues.qlock)); 	//CS on Qs
 }
 
 int env_get_recent_cpu(struct Env* e)
 {
 	//[PROJECT] BSD Scheduler - env_get_recent_cpu
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
+	//100 times the recent_cpu, rounded
+	return fix_round(fix_scale(e->recent_cpu, 100));
 }
 int get_load_average()
 {
 	//return 1;
 	//[PROJECT] BSD Scheduler - get_load_average
-	//Your code is here
-	//Comment the following line
-	panic("Not implemented yet");
-	return 0;
+	//100 times the load_avg, rounded
+	return fix_round(fix_scale(load_avg, 100));
 }
 /********* for BSD Priority Scheduler *************/
 //==================================================================================//
@@ -732,9 +1088,39 @@ void env_set_priority(int envID, int priority)
 	}
 }
 
+/*2026*/
+/********* for Stride Scheduler *************/
+//Set the tickets of the given env (clamped to [1, STRIDE_MAX_TICKETS]). Its
+//pass is kept: the new stride applies from the next quantum it runs.
+int env_set_tickets(int envID, uint32 tickets)
+{
+	struct Env* proc;
+	if (envid2env(envID, &proc, 0) < 0 || proc == NULL)
+		return E_BAD_ENV;
+
+	if (tickets < 1)
+		tickets = 1;
+	if (tickets > STRIDE_MAX_TICKETS)
+		tickets = STRIDE_MAX_TICKETS;
+
+	bool lock_already_held = holding_spinlock(&ProcessQueues.qlock);
+	if (!lock_already_held)
+		acquire_spinlock(&(ProcessQueues.qlock)); 	//CS on Qs
+	{
+		proc->tickets = tickets;
+		proc->stride = STRIDE1 / tickets;
+	}
+	if (!lock_already_held)
+		release_spinlock(&(ProcessQueues.qlock)); 	//CS on Qs
+	return 0;
+}
+/********* for Stride Scheduler *************/
+
 void sched_set_starv_thresh(uint32 starvThresh)
 {
 	//TODO: [PROJECT'24.MS3 - #06] [3] PRIORITY RR Scheduler - sched_set_starv_thresh
 	//Your code is here
 	starvation_threshold = starvThresh;
+	//2026: the bounds were computed with the former threshold: recheck all the queues
+	memset(prirr_queue_due, 0, sizeof(prirr_queue_due));
 }
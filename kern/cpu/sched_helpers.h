@@ -20,6 +20,26 @@ int get_load_average() ;
 void env_set_priority(int envID, int priority);
 void sched_set_starv_thresh(uint32 starvThresh);
 
+/*2026*/
+int env_set_tickets(int envID, uint32 tickets);
+struct Env* sched_stride_min(void);
+
+
+//2026: ready queues with a non-empty bitmap (ProcessQueues.qlock must be held)
+void sched_ready_reset(void);
+void sched_ready_enqueue(uint8 queue_index, struct Env* env);
+struct Env* sched_ready_dequeue(uint8 queue_index);
+void sched_ready_unlink(struct Env* env);
+uint32 sched_starvation_due(struct Env* env);
+int sched_ready_first(void);
+
+//2026: scheduler accounting
+void sched_account(struct Env* env, uint8 new_state);
+void sched_print_stats(void);
+
+//2026: lock-free wakeups
+void sched_wakeup_lockfree(struct Env* env);
+void sched_drain_wakeups(void);
 
 void sched_insert_ready0(struct Env* env);
 void sched_insert_ready(struct Env* env);
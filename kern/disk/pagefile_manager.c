@@ -2,6 +2,8 @@
 
 /// ==========================================================================
 /// THIS PAGE FILE MANAGMENT DOES NOT SUPPORT MEMORY SHARING !
+/// (except for disk frames shared by fork(): these are reference counted and
+///  a private copy is taken before any of the sharing envs writes to it)
 /// ==========================================================================
 
 #include "pagefile_manager.h"
@@ -124,6 +126,7 @@ int allocate_disk_frame(uint32 *dfn)
 		{
 			LIST_REMOVE(&DiskFrameLists.disk_free_frame_list, ptr_frame_info);
 			initialize_frame_info(ptr_frame_info);
+			ptr_frame_info->references = 1;
 			*dfn = to_disk_frame_number(ptr_frame_info);
 		}
 	}
@@ -133,7 +136,8 @@ int allocate_disk_frame(uint32 *dfn)
 }
 
 //
-// Return a frame to the disk_free_frame_list.
+// Drop one reference to a disk frame and return it to the
+// disk_free_frame_list once no env refers to it anymore.
 //
 void free_disk_frame(uint32 dfn)
 {
@@ -141,11 +145,34 @@ void free_disk_frame(uint32 dfn)
 	if(dfn == 0) return;
 	acquire_spinlock(&DiskFrameLists.dfllock);
 	{
-		LIST_INSERT_HEAD(&DiskFrameLists.disk_free_frame_list, &disk_frames_info[dfn]);
+		struct FrameInfo *ptr_frame_info = &disk_frames_info[dfn];
+		if (ptr_frame_info->references > 0)
+			ptr_frame_info->references--;
+		if (ptr_frame_info->references == 0)
+			LIST_INSERT_HEAD(&DiskFrameLists.disk_free_frame_list, ptr_frame_info);
 	}
 	release_spinlock(&DiskFrameLists.dfllock);
 }
 
+//
+// Before overwriting the disk page at 'virtual_address', make sure it is not
+// shared with a forked env anymore: if it is, switch this entry to a new disk
+// frame (no need to copy, the caller writes the whole page).
+//
+static int pf_unshare_disk_frame(uint32 *ptr_disk_page_table, uint32 virtual_address)
+{
+	uint32 dfn = ptr_disk_page_table[PTX(virtual_address)];
+	if (dfn == 0 || disk_frames_info[dfn].references <= 1)
+		return 0;
+
+	uint32 new_dfn;
+	if (allocate_disk_frame(&new_dfn) == E_NO_PAGE_FILE_SPACE)
+		return E_NO_PAGE_FILE_SPACE;
+	free_disk_frame(dfn);
+	ptr_disk_page_table[PTX(virtual_address)] = new_dfn;
+	return 0;
+}
+
 int get_disk_page_table(uint32 *ptr_disk_page_directory, const uint32 virtual_address, int create, uint32 **ptr_disk_page_table)
 {
 	// Fill this function in
@@ -252,6 +279,11 @@ int pf_add_env_page( struct Env* ptr_env, uint32 virtual_address, void* dataSrc)
 		if( allocate_disk_frame(&dfn) == E_NO_PAGE_FILE_SPACE) return E_NO_PAGE_FILE_SPACE;
 		ptr_disk_page_table[PTX(virtual_address)] = dfn;
 	}
+	else
+	{
+		if (pf_unshare_disk_frame(ptr_disk_page_table, virtual_address) == E_NO_PAGE_FILE_SPACE) return E_NO_PAGE_FILE_SPACE;
+		dfn = ptr_disk_page_table[PTX(virtual_address)];
+	}
 
 	//TODOObsolete: we should here lcr3 with the env pgdir to make sure that dataSrc is not read mistakenly
 	// from another env directory
@@ -338,6 +370,8 @@ int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct Frame
 
 
 	get_disk_page_table(ptr_env->disk_env_pgdir, virtual_address, 0, &ptr_disk_page_table);
+	if (pf_unshare_disk_frame(ptr_disk_page_table, virtual_address) == E_NO_PAGE_FILE_SPACE)
+		panic("pf_update_env_page: attempt to unshare a forked page, but page file out of space!") ;
 	uint32 dfn=ptr_disk_page_table[PTX(virtual_address)];
 
 #if USE_KHEAP
@@ -441,6 +475,40 @@ void pf_remove_env_page(struct Env* ptr_env, uint32 virtual_address)
 	//LOG_STRING("pf_remove_env_page: 3");
 }
 
+//2026: Detach the disk page of the given VA from the env WITHOUT freeing it:
+//its reference moves to the caller, that gives it to another VA/env by
+//pf_put_env_page() (i.e. a page moves without reading/writing the disk)
+//Returns its dfn (0 if the page isn't in the page file)
+uint32 pf_take_env_page(struct Env* ptr_env, uint32 virtual_address)
+{
+	uint32 *ptr_disk_page_table;
+	if( ptr_env->disk_env_pgdir == 0) return 0;
+
+	get_disk_page_table(ptr_env->disk_env_pgdir, virtual_address, 0, &ptr_disk_page_table);
+	if(ptr_disk_page_table == 0) return 0;
+
+	uint32 dfn=ptr_disk_page_table[PTX(virtual_address)];
+	ptr_disk_page_table[PTX(virtual_address)] = 0;
+	return dfn;
+}
+
+//2026: Attach the disk page dfn (taken by pf_take_env_page) at the given VA
+//of the env, dropping its current page there (if any)
+int pf_put_env_page(struct Env* ptr_env, uint32 virtual_address, uint32 dfn)
+{
+	uint32 *ptr_disk_page_table;
+	assert((uint32)virtual_address < KERNEL_BASE);
+
+	get_disk_page_directory(ptr_env, &(ptr_env->disk_env_pgdir)) ;
+
+	if (get_disk_page_table(ptr_env->disk_env_pgdir,  virtual_address, 1, &ptr_disk_page_table) == E_NO_VM)
+		return E_NO_VM;
+
+	free_disk_frame(ptr_disk_page_table[PTX(virtual_address)]);
+	ptr_disk_page_table[PTX(virtual_address)] = dfn;
+	return 0;
+}
+
 void pf_free_env(struct Env* ptr_env)
 {
 	uint32 pdeno;
@@ -559,6 +627,43 @@ int get_disk_page_directory(struct Env* ptr_env, uint32** ptr_disk_page_director
 	return 0;
 }
 
+//
+// Make 'child' refer to every page 'parent' has in the page file.
+// The disk frames are shared by reference, not copied.
+//
+int pf_clone_env(struct Env* parent, struct Env* child)
+{
+	int ret = get_disk_page_directory(child, &(child->disk_env_pgdir));
+	if (ret != 0 || parent->disk_env_pgdir == 0)
+		return ret;
+
+	for (uint32 pdeno = 0; pdeno < PDX(USER_TOP) ; pdeno++)
+	{
+		// only look at mapped page tables
+		if (!(parent->disk_env_pgdir[pdeno] & PERM_PRESENT))
+			continue;
+
+		uint32 *parent_pt, *child_pt;
+		uint32 table_va = (uint32)PGADDR(pdeno, 0, 0);
+		get_disk_page_table(parent->disk_env_pgdir, table_va, 0, &parent_pt);
+		ret = get_disk_page_table(child->disk_env_pgdir, table_va, 1, &child_pt);
+		if (ret != 0)
+			return ret;
+
+		acquire_spinlock(&DiskFrameLists.dfllock);
+		for (uint32 pteno = 0; pteno < 1024; pteno++)
+		{
+			uint32 dfn = parent_pt[pteno];
+			if (dfn == 0)
+				continue;
+			child_pt[pteno] = dfn;
+			disk_frames_info[dfn].references++;
+		}
+		release_spinlock(&DiskFrameLists.dfllock);
+	}
+	return 0;
+}
+
 int pf_calculate_allocated_pages(struct Env* ptr_env)
 {
 	uint32 *pt;
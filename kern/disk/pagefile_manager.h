@@ -30,6 +30,10 @@ int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct Frame
 //int pf_special_update_env_modified_page(struct Env* ptr_env, uint32 virtual_address, struct Frame_Info* page_modified_frame_info);
 int pf_read_env_page(struct Env* ptr_env, void* virtual_address);
 void pf_remove_env_page(struct Env* ptr_env, uint32 virtual_address);
+uint32 pf_take_env_page(struct Env* ptr_env, uint32 virtual_address);			//2026
+int pf_put_env_page(struct Env* ptr_env, uint32 virtual_address, uint32 dfn);	//2026
+void free_disk_frame(uint32 dfn);	//2026: drop a taken disk page
+int pf_clone_env(struct Env* parent, struct Env* child);
 ///=============================================================================================
 
 int pf_calculate_allocated_pages(struct Env* ptr_env);
@@ -13,6 +13,7 @@
 #include "kern/cmd/command_prompt.h"
 #include "kern/cmd/commands.h"
 #include <kern/cpu/kclock.h>
+#include <kern/cpu/ktimer.h>
 #include <kern/cpu/cpu.h>
 #include <kern/cpu/sched.h>
 #include <kern/cpu/picirq.h>
@@ -21,6 +22,8 @@
 #include <kern/mem/kheap.h>
 #include <kern/mem/memory_manager.h>
 #include <kern/mem/shared_memory_manager.h>
+#include <kern/conc/futex.h>
+#include <kern/conc/ipc.h>
 #include <kern/tests/utilities.h>
 #include <kern/tests/test_kheap.h>
 #include <kern/tests/test_dynamic_allocator.h>
@@ -76,6 +79,8 @@ void FOS_initialize()
 		initialize_kernel_VM();
 		initialize_paging();
 		sharing_init();
+		futex_init();
+		ipc_init();
 
 #if USE_KHEAP
 		initialize_kheap_dynamic_allocator(KERNEL_HEAP_START, PAGE_SIZE, KERNEL_HEAP_START + DYN_ALLOC_MAX_SIZE);
@@ -129,6 +134,7 @@ void FOS_initialize()
 	{
 		// Lab 4 multitasking initialization functions
 		kclock_init();
+		ktimer_init();
 		sched_init() ;
 	}
 	//cprintf("* [DONE]\n");
@@ -31,6 +31,7 @@ struct
 {
 	struct FrameInfo_List free_frame_list;		// Free list of physical frames_info
 	struct FrameInfo_List modified_frame_list;	// Modified frame list for buffering
+	struct FrameInfo_List zeroed_frame_list;	// Free frames already filled with 0's (refilled while the CPU is idle)
 	struct spinlock mfllock;					// Lock to protect the frame info lists
 } MemFrameLists;
 
@@ -19,6 +19,114 @@
 /*[1] RAM CHUNKS MANIPULATION */
 /******************************/
 
+//2026: the chunk operations below walk their range a page table at a time:
+//each table is looked up (or created) once, then its entries are accessed
+//directly. They check the whole range first, then change it, so a denied
+//call leaves the address space untouched.
+
+//Page table covering va (NULL if it doesn't exist & create is not set)
+static uint32* chunk_page_table(uint32* page_directory, uint32 va, int create)
+{
+	uint32 *ptr_page_table = NULL;
+	if (get_page_table(page_directory, va, &ptr_page_table) == TABLE_NOT_EXIST && create)
+		ptr_page_table = create_page_table(page_directory, va);
+	return ptr_page_table;
+}
+
+//# pages of the num_of_pages pages starting at va that are covered by the table of va
+static inline uint32 chunk_span(uint32 va, uint32 num_of_pages)
+{
+	return MIN(num_of_pages, NPTENTRIES - PTX(va));
+}
+
+//# pages touched by [va, va + size)
+static inline uint32 chunk_num_of_pages(uint32 va, uint32 size)
+{
+	if (size == 0)
+		return 0;
+	return size / PAGE_SIZE + (size % PAGE_SIZE + va % PAGE_SIZE + PAGE_SIZE - 1) / PAGE_SIZE;
+}
+
+//# page tables touched by num_of_pages pages starting at va
+static inline uint32 chunk_num_of_tables(uint32 va, uint32 num_of_pages)
+{
+	if (num_of_pages == 0)
+		return 0;
+	return PDX(va + (num_of_pages - 1) * PAGE_SIZE) - PDX(va) + 1;
+}
+
+//Count the entries of the num_of_pages pages starting at va with
+//(entry & mask) == value. The # existing tables of the range is set in
+//*num_tables (if not NULL)
+static uint32 chunk_count(uint32* page_directory, uint32 va, uint32 num_of_pages, uint32 mask, uint32 value, uint32 *num_tables)
+{
+	uint32 count = 0;
+	if (num_tables != NULL)
+		*num_tables = 0;
+	while (num_of_pages > 0)
+	{
+		uint32 n = chunk_span(va, num_of_pages);
+		uint32 *ptr_page_table = chunk_page_table(page_directory, va, 0);
+		if (ptr_page_table != NULL)
+		{
+			for (uint32 i = PTX(va); i < PTX(va) + n; i++)
+				if ((ptr_page_table[i] & mask) == value)
+					count++;
+			if (num_tables != NULL)
+				(*num_tables)++;
+		}
+		else if (value == 0)
+			count += n;
+		va += n * PAGE_SIZE;
+		num_of_pages -= n;
+	}
+	return count;
+}
+
+//Set the entry of va in its table, keeping the live PTE count of the table
+//up-to-date
+static inline void chunk_set_entry(uint32* page_directory, uint32 *ptr_page_table, uint32 va, uint32 new_entry)
+{
+	uint32 old_entry = ptr_page_table[PTX(va)];
+	ptr_page_table[PTX(va)] = new_entry;
+	pt_update_live_count(page_directory, va, old_entry, new_entry);
+}
+
+//Kernel address of the frame of a present entry: pages are copied through
+//it, whatever the current address space is
+static inline uint8* chunk_frame_kva(uint32 entry)
+{
+	return (uint8*)STATIC_KERNEL_VIRTUAL_ADDRESS(EXTRACT_ADDRESS(entry));
+}
+
+//Remembers the last table looked up, so that a sequential scan of a range
+//looks up each table once
+struct chunk_cursor
+{
+	uint32 *ptr_page_table;
+	uint32 pdx;
+};
+
+static inline uint32 chunk_entry(uint32* page_directory, struct chunk_cursor *c, uint32 va)
+{
+	if (c->ptr_page_table == NULL || c->pdx != PDX(va))
+	{
+		c->ptr_page_table = chunk_page_table(page_directory, va, 0);
+		c->pdx = PDX(va);
+		if (c->ptr_page_table == NULL)
+			return 0;
+	}
+	return c->ptr_page_table[PTX(va)];
+}
+
+static struct FrameInfo* chunk_new_frame()
+{
+	struct FrameInfo *ptr_frame_info = NULL;
+	allocate_zeroed_frame(&ptr_frame_info);
+	ptr_frame_info->references++;
+	return ptr_frame_info;
+}
+
 //===============================
 // 1) CUT-PASTE PAGES IN RAM:
 //===============================
@@ -29,9 +137,43 @@
 //	The given addresses may be not aligned on 4 KB
 int cut_paste_pages(uint32* page_directory, uint32 source_va, uint32 dest_va, uint32 num_of_pages)
 {
-	//[PROJECT] [CHUNK OPERATIONS] cut_paste_pages
-	// Write your code here, remove the panic and write your code
-	panic("cut_paste_pages() is not implemented yet...!!");
+	source_va = ROUNDDOWN(source_va, PAGE_SIZE);
+	dest_va = ROUNDDOWN(dest_va, PAGE_SIZE);
+	if (num_of_pages == 0 || source_va == dest_va)
+		return 0;
+	//2026: overlapped ranges are denied as well
+	uint32 dist = source_va < dest_va ? dest_va - source_va : source_va - dest_va;
+	if (dist / PAGE_SIZE < num_of_pages)
+		return -1;
+	if (chunk_count(page_directory, dest_va, num_of_pages, PERM_PRESENT, PERM_PRESENT, NULL) > 0)
+		return -1;
+
+	//the whole entry moves (frame, permissions & available bits): the frame
+	//keeps its references
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, page_directory);
+	while (num_of_pages > 0)
+	{
+		uint32 n = MIN(chunk_span(source_va, num_of_pages), chunk_span(dest_va, num_of_pages));
+		uint32 *dst_page_table = chunk_page_table(page_directory, dest_va, 1);
+		uint32 *src_page_table = chunk_page_table(page_directory, source_va, 0);
+		for (uint32 i = 0; i < n; i++, source_va += PAGE_SIZE, dest_va += PAGE_SIZE)
+		{
+			uint32 entry = src_page_table != NULL ? src_page_table[PTX(source_va)] : 0;
+			if (entry == 0)
+				continue;
+			chunk_set_entry(page_directory, dst_page_table, dest_va, entry);
+			chunk_set_entry(page_directory, src_page_table, source_va, 0);
+			if (entry & PERM_PRESENT)
+			{
+				to_frame_info(EXTRACT_ADDRESS(entry))->mapped_page_virtual_address = PPN(dest_va);
+				tlb_batch_add(&batch, source_va);
+			}
+		}
+		num_of_pages -= n;
+	}
+	tlb_batch_flush(&batch);
+	return 0;
 }
 
 //===============================
@@ -48,9 +190,52 @@ int cut_paste_pages(uint32* page_directory, uint32 source_va, uint32 dest_va, ui
 //	The given range(s) may be not aligned on 4 KB
 int copy_paste_chunk(uint32* page_directory, uint32 source_va, uint32 dest_va, uint32 size)
 {
-	//[PROJECT] [CHUNK OPERATIONS] copy_paste_chunk
-	// Write your code here, remove the //panic and write your code
-	panic("copy_paste_chunk() is not implemented yet...!!");
+	if (size == 0)
+		return 0;
+	uint32 dst_pages = chunk_num_of_pages(dest_va, size);
+	uint32 src_pages = chunk_num_of_pages(source_va, size);
+	if (chunk_count(page_directory, ROUNDDOWN(dest_va, PAGE_SIZE), dst_pages, PERM_PRESENT | PERM_WRITEABLE, PERM_PRESENT, NULL) > 0)
+		return -1;
+	//2026: the source is read through its frames, so it must be in memory
+	if (chunk_count(page_directory, ROUNDDOWN(source_va, PAGE_SIZE), src_pages, PERM_PRESENT, PERM_PRESENT, NULL) != src_pages)
+		return -1;
+
+	struct chunk_cursor src = { NULL, 0 };
+	uint32 copied = 0;
+	uint32 va = ROUNDDOWN(dest_va, PAGE_SIZE);
+	while (dst_pages > 0)
+	{
+		uint32 n = chunk_span(va, dst_pages);
+		uint32 *ptr_page_table = chunk_page_table(page_directory, va, 1);
+		for (uint32 i = 0; i < n; i++, va += PAGE_SIZE)
+		{
+			uint32 entry = ptr_page_table[PTX(va)];
+			if (!(entry & PERM_PRESENT))
+			{
+				uint32 src_entry = chunk_entry(page_directory, &src, source_va + copied);
+				entry = CONSTRUCT_ENTRY(to_physical_address(chunk_new_frame()),
+						(entry & PERM_AVAILABLE) | (src_entry & PERM_USER) | PERM_WRITEABLE | PERM_PRESENT);
+			}
+			//written behind the MMU: mark it modified for the page replacement
+			chunk_set_entry(page_directory, ptr_page_table, va, entry | PERM_MODIFIED);
+
+			//the part of this page in the range may come from 2 source pages
+			uint32 offset = (va < dest_va) ? dest_va - va : 0;
+			uint32 len = MIN(PAGE_SIZE - offset, size - copied);
+			while (len > 0)
+			{
+				uint32 src_va = source_va + copied;
+				uint32 src_len = MIN(len, PAGE_SIZE - src_va % PAGE_SIZE);
+				memcpy(chunk_frame_kva(entry) + offset,
+						chunk_frame_kva(chunk_entry(page_directory, &src, src_va)) + src_va % PAGE_SIZE, src_len);
+				offset += src_len;
+				copied += src_len;
+				len -= src_len;
+			}
+		}
+		dst_pages -= n;
+	}
+	return 0;
 }
 
 //===============================
@@ -64,9 +249,34 @@ int copy_paste_chunk(uint32* page_directory, uint32 source_va, uint32 dest_va, u
 //	The given range(s) may be not aligned on 4 KB
 int share_chunk(uint32* page_directory, uint32 source_va,uint32 dest_va, uint32 size, uint32 perms)
 {
-	//[PROJECT] [CHUNK OPERATIONS] share_chunk
-	// Write your code here, remove the //panic and write your code
-	panic("share_chunk() is not implemented yet...!!");
+	uint32 num_of_pages = chunk_num_of_pages(dest_va, size);
+	source_va = ROUNDDOWN(source_va, PAGE_SIZE);
+	dest_va = ROUNDDOWN(dest_va, PAGE_SIZE);
+	if (chunk_count(page_directory, dest_va, num_of_pages, PERM_PRESENT, PERM_PRESENT, NULL) > 0)
+		return -1;
+
+	//2026: source pages that are not in memory are not shared
+	while (num_of_pages > 0)
+	{
+		uint32 n = MIN(chunk_span(source_va, num_of_pages), chunk_span(dest_va, num_of_pages));
+		uint32 *dst_page_table = chunk_page_table(page_directory, dest_va, 1);
+		uint32 *src_page_table = chunk_page_table(page_directory, source_va, 0);
+		for (uint32 i = 0; i < n && src_page_table != NULL; i++)
+		{
+			uint32 src_entry = src_page_table[PTX(source_va) + i];
+			if (!(src_entry & PERM_PRESENT))
+				continue;
+			uint32 va = dest_va + i * PAGE_SIZE;
+			//the frame keeps its mapped_page_virtual_address: it may be a kernel heap page
+			to_frame_info(EXTRACT_ADDRESS(src_entry))->references++;
+			chunk_set_entry(page_directory, dst_page_table, va,
+					CONSTRUCT_ENTRY(EXTRACT_ADDRESS(src_entry), (dst_page_table[PTX(va)] & PERM_AVAILABLE) | perms | PERM_PRESENT));
+		}
+		source_va += n * PAGE_SIZE;
+		dest_va += n * PAGE_SIZE;
+		num_of_pages -= n;
+	}
+	return 0;
 }
 
 //===============================
@@ -78,19 +288,35 @@ int share_chunk(uint32* page_directory, uint32 source_va,uint32 dest_va, uint32
 //	Allocation should be aligned on page boundary. However, the given range may be not aligned.
 int allocate_chunk(uint32* page_directory, uint32 va, uint32 size, uint32 perms)
 {
-	//[PROJECT] [CHUNK OPERATIONS] allocate_chunk
-	// Write your code here, remove the //panic and write your code
-	panic("allocate_chunk() is not implemented yet...!!");
+	uint32 num_of_pages = chunk_num_of_pages(va, size);
+	va = ROUNDDOWN(va, PAGE_SIZE);
+	if (chunk_count(page_directory, va, num_of_pages, PERM_PRESENT, PERM_PRESENT, NULL) > 0)
+		return -1;
+
+	while (num_of_pages > 0)
+	{
+		uint32 n = chunk_span(va, num_of_pages);
+		uint32 *ptr_page_table = chunk_page_table(page_directory, va, 1);
+		for (uint32 i = 0; i < n; i++, va += PAGE_SIZE)
+		{
+			struct FrameInfo *ptr_frame_info = chunk_new_frame();
+			ptr_frame_info->mapped_page_virtual_address = PPN(va);
+			chunk_set_entry(page_directory, ptr_page_table, va,
+					CONSTRUCT_ENTRY(to_physical_address(ptr_frame_info), (ptr_page_table[PTX(va)] & PERM_AVAILABLE) | perms | PERM_PRESENT));
+		}
+		num_of_pages -= n;
+	}
+	return 0;
 }
 
 //=====================================
 // 5) CALCULATE ALLOCATED SPACE IN RAM:
 //=====================================
+//2026: # existing tables & # pages in memory in the range [sva, eva)
 void calculate_allocated_space(uint32* page_directory, uint32 sva, uint32 eva, uint32 *num_tables, uint32 *num_pages)
 {
-	//[PROJECT] [CHUNK OPERATIONS] calculate_allocated_space
-	// Write your code here, remove the panic and write your code
-	panic("calculate_allocated_space() is not implemented yet...!!");
+	uint32 pages = (eva > sva) ? chunk_num_of_pages(sva, eva - sva) : 0;
+	*num_pages = chunk_count(page_directory, ROUNDDOWN(sva, PAGE_SIZE), pages, PERM_PRESENT, PERM_PRESENT, num_tables);
 }
 
 //=====================================
@@ -101,9 +327,11 @@ void calculate_allocated_space(uint32* page_directory, uint32 sva, uint32 eva, u
 //	The given range(s) may be not aligned on 4 KB
 uint32 calculate_required_frames(uint32* page_directory, uint32 sva, uint32 size)
 {
-	//[PROJECT] [CHUNK OPERATIONS] calculate_required_frames
-	// Write your code here, remove the panic and write your code
-	panic("calculate_required_frames() is not implemented yet...!!");
+	uint32 num_of_pages = chunk_num_of_pages(sva, size);
+	sva = ROUNDDOWN(sva, PAGE_SIZE);
+	uint32 num_tables;
+	uint32 present = chunk_count(page_directory, sva, num_of_pages, PERM_PRESENT, PERM_PRESENT, &num_tables);
+	return (chunk_num_of_tables(sva, num_of_pages) - num_tables) + (num_of_pages - present);
 }
 
 //=================================================================================//
@@ -171,6 +399,8 @@ void allocate_user_mem(struct Env* e, uint32 virtual_address, uint32 size)
 	uint32 needed_page_cnt = ROUNDUP(size , PAGE_SIZE) / PAGE_SIZE; // convert size into needed number of pages
 
 	uint32 *cur_page_table = NULL;
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, e->env_page_directory);
 
 	for (uint32 cur_va = virtual_address ; needed_page_cnt ; needed_page_cnt-- , cur_va += PAGE_SIZE) {
 
@@ -180,8 +410,9 @@ void allocate_user_mem(struct Env* e, uint32 virtual_address, uint32 size)
 			create_page_table(e->env_page_directory , cur_va);
 		}
 
-		pt_set_page_permissions(e->env_page_directory , cur_va , PERM_USER_MARKED , 0); // set pages as marked
+		pt_set_page_permissions_batched(e->env_page_directory , cur_va , PERM_USER_MARKED , 0, &batch); // set pages as marked
 	}
+	tlb_batch_flush(&batch);
 	// panic("allocate_user_mem() is not implemented yet...!!");
 }
 
@@ -194,6 +425,8 @@ void free_user_mem(struct Env* e, uint32 virtual_address, uint32 size)
 	int page_cnt = ROUNDUP(size , PAGE_SIZE) / PAGE_SIZE;
 
 	uint32 *cur_page_table = NULL;
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, e->env_page_directory);
 
 	for (uint32 cur_va = virtual_address ; page_cnt ; page_cnt-- , cur_va += PAGE_SIZE) {
 
@@ -203,7 +436,7 @@ void free_user_mem(struct Env* e, uint32 virtual_address, uint32 size)
 		}
 		
 		// unmark pages
-		pt_set_page_permissions(e->env_page_directory , cur_va , 0 , PERM_USER_MARKED);
+		pt_set_page_permissions_batched(e->env_page_directory , cur_va , 0 , PERM_USER_MARKED, &batch);
 
 		// free pages from page file
 		pf_remove_env_page(e, cur_va);
@@ -214,12 +447,25 @@ void free_user_mem(struct Env* e, uint32 virtual_address, uint32 size)
 			continue;
 		}
 		
-		struct WorkingSetElement *wse = frame->wse;
+		if (e->page_WS_array != NULL) {
+			int i = env_page_ws_array_find(e, cur_va);
+			unmap_frame_batched(e->env_page_directory, cur_va, &batch);
+			if (i >= 0) {
+				env_page_ws_array_clear(e, i);
+			}
+			continue;
+		}
+
+		struct WorkingSetElement *wse = (frame->wse_dir == e->env_page_directory) ? frame->wse : NULL;
+		if (!wse) {
+			// frame shared copy-on-write after a fork and owned by the other env: search the WS
+			wse = env_page_ws_list_find_element(e, cur_va);
+		}
 		if (!wse) {
 			continue;
 		}
 
-		unmap_frame(e->env_page_directory, wse->virtual_address);
+		unmap_frame_batched(e->env_page_directory, wse->virtual_address, &batch);
 		
 		if (e->page_last_WS_element == wse)
 		{
@@ -229,6 +475,7 @@ void free_user_mem(struct Env* e, uint32 virtual_address, uint32 size)
 		LIST_REMOVE(&(e->page_WS_list), wse);
 		kfree(wse);
 	}
+	tlb_batch_flush(&batch);
 }
 
 //=====================================
@@ -243,11 +490,60 @@ void __free_user_mem_with_buffering(struct Env* e, uint32 virtual_address, uint3
 //=====================================
 // 3) MOVE USER MEMORY:
 //=====================================
-void move_user_mem(struct Env* e, uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size)
+//2026: Move the pages of [src, src + size) to the same offsets at dst WITHOUT
+//copying them (like mremap): their PTEs (frame, permissions & marks), WS
+//entries & page file entries are moved. The source range is left free.
+//	The destination range should be free (no mapped or marked page) and not
+//	overlapped with the source, otherwise nothing is moved.
+//	The given addresses may be not aligned on 4 KB
+//RETURN: 0, or -1 if denied
+int move_user_mem(struct Env* e, uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size)
 {
-	//[PROJECT] [USER HEAP - KERNEL SIDE] move_user_mem
-	//your code is here, remove the panic and write your code
-	panic("move_user_mem() is not implemented yet...!!");
+	uint32 *page_directory = e->env_page_directory;
+	uint32 src_va = ROUNDDOWN(src_virtual_address, PAGE_SIZE);
+	uint32 dst_va = ROUNDDOWN(dst_virtual_address, PAGE_SIZE);
+	uint32 num_of_pages = ROUNDUP(size, PAGE_SIZE) / PAGE_SIZE;
+	if (num_of_pages == 0 || src_va == dst_va)
+		return 0;
+	uint32 dist = src_va < dst_va ? dst_va - src_va : src_va - dst_va;
+	if (dist / PAGE_SIZE < num_of_pages)
+		return -1;
+	if (chunk_count(page_directory, dst_va, num_of_pages, PERM_PRESENT | PERM_USER_MARKED, 0, NULL) != num_of_pages)
+		return -1;
+
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, page_directory);
+	for (uint32 va = src_va, to = dst_va, left = num_of_pages; left > 0; )
+	{
+		uint32 n = MIN(chunk_span(va, left), chunk_span(to, left));
+		uint32 *src_page_table = chunk_page_table(page_directory, va, 0);
+		uint32 *dst_page_table = (src_page_table != NULL) ? chunk_page_table(page_directory, to, 1) : NULL;
+		for (uint32 i = 0; i < n; i++, va += PAGE_SIZE, to += PAGE_SIZE)
+		{
+			uint32 entry = (src_page_table != NULL) ? src_page_table[PTX(va)] : 0;
+			if (entry != 0)
+			{
+				chunk_set_entry(page_directory, dst_page_table, to, entry);
+				chunk_set_entry(page_directory, src_page_table, va, 0);
+				if (entry & PERM_PRESENT)
+					tlb_batch_add(&batch, va);
+				//its frame & WS entry follow it
+				if (entry & ~0xFFF)
+				{
+					struct FrameInfo *frame = to_frame_info(EXTRACT_ADDRESS(entry));
+					frame->mapped_page_virtual_address = PPN(to);
+					env_page_ws_move(e, frame, va, to);
+				}
+			}
+			//its disk page (if any) moves with it: no page is read or written
+			uint32 dfn = pf_take_env_page(e, va);
+			if (dfn != 0 && pf_put_env_page(e, to, dfn) != 0)
+				panic("move_user_mem: failed to create a page file table");
+		}
+		left -= n;
+	}
+	tlb_batch_flush(&batch);
+	return 0;
 }
 
 //=================================================================================//
@@ -28,7 +28,7 @@ int allocate_chunk(uint32* page_directory, uint32 va, uint32 size, uint32 perms)
 void* sys_sbrk(int numOfPages);
 void free_user_mem(struct Env* e, uint32 virtual_address, uint32 size);
 void allocate_user_mem(struct Env* e, uint32 virtual_address, uint32 size);
-void move_user_mem(struct Env* e, uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size);
+int move_user_mem(struct Env* e, uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size);
 void __free_user_mem_with_buffering(struct Env* e, uint32 virtual_address, uint32 size);
 
 #endif /* KERN_MEM_CHUNK_OPERATIONS_H_ */
@@ -236,6 +236,8 @@ void kfree(void* virtual_address)
 		virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
 		struct HeapBlock* blk = to_heap_block((uint32) virtual_address);
 		uint32 alloc_sz = blk->page_count * PAGE_SIZE;
+		struct tlb_batch batch;
+		tlb_batch_init(&batch, ptr_page_directory);
 
 		for (void* va = virtual_address; va < virtual_address + alloc_sz; va += PAGE_SIZE) {
 			uint32 pa = kheap_physical_address((uint32) va);
@@ -247,9 +249,9 @@ void kfree(void* virtual_address)
 				      to_frame_number(frame_info));
 			}
 
-			// Should invalidate cache
-			unmap_frame(ptr_page_directory, (uint32) va);
+			unmap_frame_batched(ptr_page_directory, (uint32) va, &batch);
 		}
+		tlb_batch_flush(&batch);
 
 		insert_heap_block_sorted(blk);
 		coalescing_heap_block(blk);
@@ -473,6 +475,8 @@ kexpand_block(uint32 va, uint32 required_pages)
 
 void
 remap_frames(uint32 va, uint32 new_va, uint32 size) {
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, ptr_page_directory);
 
 	for (uint32 i = 0; i < size; i++, va += PAGE_SIZE, new_va += PAGE_SIZE) {
 		uint32 *page_table = NULL;
@@ -481,9 +485,10 @@ remap_frames(uint32 va, uint32 new_va, uint32 size) {
 		if(frame_info == NULL){
 			panic("Remap_frames(): not allocated VA '%x'", va);
 		}
-		unmap_frame(ptr_page_directory, new_va);
+		unmap_frame_batched(ptr_page_directory, new_va, &batch);
 		map_frame(ptr_page_directory, frame_info, new_va, perm);
 	}
+	tlb_batch_flush(&batch);
 
 }
 
@@ -501,9 +506,12 @@ kmap_frames(uint32 virtual_address, uint32 required_pages) {
 	// Allocation failed
 	if (status != 0) {
 		// Release allocated frames
+		struct tlb_batch batch;
+		tlb_batch_init(&batch, ptr_page_directory);
 		for (uint32 allocated_va = virtual_address; allocated_va < va; allocated_va += PAGE_SIZE) {
-			unmap_frame(ptr_page_directory, allocated_va);
+			unmap_frame_batched(ptr_page_directory, allocated_va, &batch);
 		}
+		tlb_batch_flush(&batch);
 
 		return 0;
 	}
@@ -36,6 +36,81 @@ void tlb_invalidate(uint32 *ptr_page_directory, void *virtual_address)
 	invlpg(virtual_address);
 }
 
+//===============================
+// TLB FLUSH BATCHING:
+//===============================
+void
+tlb_batch_init(struct tlb_batch *batch, uint32 *pgdir)
+{
+	batch->pgdir = pgdir;
+	batch->count = 0;
+	batch->flush_all = 0;
+}
+
+// Record 'virtual_address' for invalidation at the next tlb_batch_flush().
+// Once more than TLB_BATCH_MAX pages are collected, the batch degrades into
+// a single full flush.
+void
+tlb_batch_add(struct tlb_batch *batch, uint32 virtual_address)
+{
+	if (batch->flush_all)
+		return;
+	if (batch->count == TLB_BATCH_MAX) {
+		batch->flush_all = 1;
+		return;
+	}
+	batch->vas[batch->count++] = ROUNDDOWN(virtual_address, PAGE_SIZE);
+}
+
+// Invalidate every entry collected in 'batch' and reset it.
+// NOTE: with NCPUS == 1 only the local TLB can hold stale entries. Once more
+// CPUs are brought up, this is the single place that should also send the
+// shootdown (vas[] or flush_all) to the other CPUs running 'batch->pgdir'.
+void
+tlb_batch_flush(struct tlb_batch *batch)
+{
+	if (batch->flush_all) {
+		tlbflush();
+	} else {
+		for (uint32 i = 0; i < batch->count; i++)
+			tlb_invalidate(batch->pgdir, (void *)batch->vas[i]);
+	}
+	batch->count = 0;
+	batch->flush_all = 0;
+}
+
+//===============================
+// LIVE PTE ACCOUNTING:
+//===============================
+// Every user page table keeps the # of its live entries in the FrameInfo of
+// the frame holding it. All writers of user PTEs must report the old & new
+// entry here so that emptiness checks and env_free() stay O(1) per table.
+void
+pt_update_live_count(uint32 *ptr_page_directory, uint32 virtual_address, uint32 old_entry, uint32 new_entry)
+{
+	if (CHECK_IF_KERNEL_ADDRESS(virtual_address))
+		return;
+
+	int delta = PTE_IS_LIVE(new_entry) - PTE_IS_LIVE(old_entry);
+	if (delta == 0)
+		return;
+
+	struct FrameInfo *table_frame = to_frame_info(EXTRACT_ADDRESS(ptr_page_directory[PDX(virtual_address)]));
+	table_frame->live_ptes += delta;
+}
+
+// Return the # of live entries in the table covering 'virtual_address'
+// (0 if the table doesn't exist in memory).
+uint32
+pt_live_count(uint32 *ptr_page_directory, uint32 virtual_address)
+{
+	uint32 page_directory_entry = ptr_page_directory[PDX(virtual_address)];
+	if ((page_directory_entry & PERM_PRESENT) != PERM_PRESENT)
+		return 0;
+
+	return to_frame_info(EXTRACT_ADDRESS(page_directory_entry))->live_ptes;
+}
+
 ///******************************* MAPPING USER SPACE *******************************
 
 // --------------------------------------------------------------
@@ -69,6 +144,8 @@ void initialize_paging()
 	int i;
 	LIST_INIT(&MemFrameLists.free_frame_list);
 	LIST_INIT(&MemFrameLists.modified_frame_list);
+	LIST_INIT(&MemFrameLists.zeroed_frame_list);
+	memset(&zeroed_frames_counters, 0, sizeof(zeroed_frames_counters));
 
 	//Initialize the corresponding lock
 	init_spinlock(&MemFrameLists.mfllock, "Frame Info Lock");
@@ -156,6 +233,18 @@ int allocate_frame(struct FrameInfo **ptr_frame_info)
 
 	*ptr_frame_info = LIST_FIRST(&MemFrameLists.free_frame_list);
 	int c = 0;
+	if (*ptr_frame_info == NULL && LIST_SIZE(&MemFrameLists.zeroed_frame_list) > 0)
+	{
+		//Only pre-zeroed frames are left: use them as normal free frames
+		*ptr_frame_info = LIST_FIRST(&MemFrameLists.zeroed_frame_list);
+		LIST_REMOVE(&MemFrameLists.zeroed_frame_list, *ptr_frame_info);
+		initialize_frame_info(*ptr_frame_info);
+		if (!lock_already_held)
+		{
+			release_spinlock(&MemFrameLists.mfllock);
+		}
+		return 0;
+	}
 	if (*ptr_frame_info == NULL)
 	{
 		//[PROJECT] Free RAM when it's FULL
@@ -187,6 +276,73 @@ int allocate_frame(struct FrameInfo **ptr_frame_info)
 	return 0;
 }
 
+//
+// Allocates a physical frame whose contents are all 0's.
+// It's taken from the pre-zeroed pool if possible, otherwise a free frame
+// is allocated and zeroed here.
+// Same return values as allocate_frame()
+//
+int allocate_zeroed_frame(struct FrameInfo **ptr_frame_info)
+{
+	bool lock_already_held = holding_spinlock(&MemFrameLists.mfllock);
+
+	if (!lock_already_held)
+	{
+		acquire_spinlock(&MemFrameLists.mfllock);
+	}
+	*ptr_frame_info = LIST_FIRST(&MemFrameLists.zeroed_frame_list);
+	if (*ptr_frame_info != NULL)
+	{
+		LIST_REMOVE(&MemFrameLists.zeroed_frame_list, *ptr_frame_info);
+		initialize_frame_info(*ptr_frame_info);
+		zeroed_frames_counters.hits++;
+	}
+	if (!lock_already_held)
+	{
+		release_spinlock(&MemFrameLists.mfllock);
+	}
+	if (*ptr_frame_info != NULL)
+		return 0;
+
+	int ret = allocate_frame(ptr_frame_info);
+	memset(STATIC_KERNEL_VIRTUAL_ADDRESS(to_physical_address(*ptr_frame_info)), 0, PAGE_SIZE);
+	zeroed_frames_counters.misses++;
+	return ret;
+}
+
+//
+// Move up to max_frames free frames into the pre-zeroed pool (without
+// exceeding ZEROED_FRAMES_POOL_SIZE). Meant to be called when the CPU has
+// nothing else to do: the lock is not held while zeroing.
+// Buffered frames are left in the free list since they still hold a page.
+// RETURNS the # of frames zeroed
+//
+uint32 refill_zeroed_frames(uint32 max_frames)
+{
+	uint32 n = 0;
+	for (; n < max_frames; n++)
+	{
+		acquire_spinlock(&MemFrameLists.mfllock);
+		struct FrameInfo *ptr_frame_info = LIST_LAST(&MemFrameLists.free_frame_list);
+		if (LIST_SIZE(&MemFrameLists.zeroed_frame_list) >= ZEROED_FRAMES_POOL_SIZE ||
+			ptr_frame_info == NULL || ptr_frame_info->isBuffered)
+		{
+			release_spinlock(&MemFrameLists.mfllock);
+			break;
+		}
+		LIST_REMOVE(&MemFrameLists.free_frame_list, ptr_frame_info);
+		release_spinlock(&MemFrameLists.mfllock);
+
+		memset(STATIC_KERNEL_VIRTUAL_ADDRESS(to_physical_address(ptr_frame_info)), 0, PAGE_SIZE);
+
+		acquire_spinlock(&MemFrameLists.mfllock);
+		LIST_INSERT_HEAD(&MemFrameLists.zeroed_frame_list, ptr_frame_info);
+		zeroed_frames_counters.zeroedWhenIdle++;
+		release_spinlock(&MemFrameLists.mfllock);
+	}
+	return n;
+}
+
 //
 // Return a frame to the free_frame_list.
 // (This function should only be called when ptr_frame_info->references reaches 0.)
@@ -313,6 +469,7 @@ void * create_page_table(uint32 *ptr_directory, const uint32 virtual_address)
 
 	//================
 	memset(ptr_page_table , 0, PAGE_SIZE);
+	to_frame_info(EXTRACT_ADDRESS(ptr_directory[PDX(virtual_address)]))->live_ptes = 0;
 	tlbflush();
 
 #else
@@ -328,14 +485,14 @@ void * create_page_table(uint32 *ptr_directory, const uint32 virtual_address)
 void __static_cpt(uint32 *ptr_directory, const uint32 virtual_address, uint32 **ptr_page_table)
 {
 	struct FrameInfo* ptr_new_frame_info;
-	int err = allocate_frame(&ptr_new_frame_info) ;
+	int err = allocate_zeroed_frame(&ptr_new_frame_info) ;
 
 	uint32 phys_page_table = to_physical_address(ptr_new_frame_info);
 	*ptr_page_table = STATIC_KERNEL_VIRTUAL_ADDRESS(phys_page_table) ;
 	ptr_new_frame_info->references = 1;
+	ptr_new_frame_info->live_ptes = 0;
 	ptr_directory[PDX(virtual_address)] = CONSTRUCT_ENTRY(phys_page_table, PERM_PRESENT | PERM_USER | PERM_WRITEABLE);
-	//initialize new page table by 0's
-	memset(*ptr_page_table , 0, PAGE_SIZE);
+	//new page table is already initialized by 0's
 	tlbflush();
 }
 //
@@ -397,8 +554,10 @@ int map_frame(uint32 *ptr_page_directory, struct FrameInfo *ptr_frame_info, uint
 	/*********************************************************************************/
 	/*NEW'23 el7:)
 	 * [DONE] map_frame(): KEEP THE VALUES OF THE AVAILABLE BITS*/
-	uint32 pte_available_bits = ptr_page_table[PTX(virtual_address)] & PERM_AVAILABLE;
+	uint32 old_entry = ptr_page_table[PTX(virtual_address)];
+	uint32 pte_available_bits = old_entry & PERM_AVAILABLE;
 	ptr_page_table[PTX(virtual_address)] = CONSTRUCT_ENTRY(physical_address , pte_available_bits | perm | PERM_PRESENT);
+	pt_update_live_count(ptr_page_directory, virtual_address, old_entry, ptr_page_table[PTX(virtual_address)]);
 	/*********************************************************************************/
 
 	return 0;
@@ -454,23 +613,40 @@ struct FrameInfo * get_frame_info(uint32 *ptr_page_directory, uint32 virtual_add
 //
 void unmap_frame(uint32 *ptr_page_directory, uint32 virtual_address)
 {
-	// Fill this function in
+	unmap_frame_batched(ptr_page_directory, virtual_address, NULL);
+}
+
+// Same as unmap_frame(), but when 'batch' is not NULL the TLB invalidation
+// is deferred to tlb_batch_flush(batch).
+void unmap_frame_batched(uint32 *ptr_page_directory, uint32 virtual_address, struct tlb_batch *batch)
+{
 	uint32 *ptr_page_table;
 	struct FrameInfo* ptr_frame_info = get_frame_info(ptr_page_directory, virtual_address, &ptr_page_table);
 	if( ptr_frame_info != 0 )
 	{
 		if (ptr_frame_info->isBuffered && !CHECK_IF_KERNEL_ADDRESS((uint32)virtual_address))
 			cprintf("WARNING: Freeing BUFFERED frame at va %x!!!\n", virtual_address) ;
+		//2026: its WS element (if it's of this env) is going with this mapping
+		if (ptr_frame_info->wse_dir == ptr_page_directory)
+		{
+			ptr_frame_info->wse = NULL;
+			ptr_frame_info->wse_dir = NULL;
+		}
 		decrement_references(ptr_frame_info);
 
 		/*********************************************************************************/
 		/*NEW'23 el7:)
 		 * [DONE] unmap_frame(): KEEP THE VALUES OF THE AVAILABLE BITS*/
-		uint32 pte_available_bits = ptr_page_table[PTX(virtual_address)] & PERM_AVAILABLE;
+		uint32 old_entry = ptr_page_table[PTX(virtual_address)];
+		uint32 pte_available_bits = old_entry & PERM_AVAILABLE;
 		ptr_page_table[PTX(virtual_address)] = pte_available_bits;
+		pt_update_live_count(ptr_page_directory, virtual_address, old_entry, pte_available_bits);
 		/*********************************************************************************/
 
-		tlb_invalidate(ptr_page_directory, (void *)virtual_address);
+		if (batch != NULL)
+			tlb_batch_add(batch, virtual_address);
+		else
+			tlb_invalidate(ptr_page_directory, (void *)virtual_address);
 	}
 }
 
@@ -522,7 +698,9 @@ int loadtime_map_frame(uint32 *ptr_page_directory, struct FrameInfo *ptr_frame_i
 	}
 
 	ptr_frame_info->references++;
+	uint32 old_entry = ptr_page_table[PTX(virtual_address)];
 	ptr_page_table[PTX(virtual_address)] = CONSTRUCT_ENTRY(physical_address , perm | PERM_PRESENT);
+	pt_update_live_count(ptr_page_directory, virtual_address, old_entry, ptr_page_table[PTX(virtual_address)]);
 
 	return 0;
 }
@@ -561,6 +739,7 @@ struct freeFramesCounters calculate_available_frames()
 			else
 				totalFreeUnBuffered++ ;
 		}
+		totalFreeUnBuffered += LIST_SIZE(&MemFrameLists.zeroed_frame_list);
 
 		/*2023: UPDATE based on suggestion from T112 2023.Term1*/
 		totalModified= LIST_SIZE(&MemFrameLists.modified_frame_list);
@@ -88,6 +88,48 @@ static inline struct FrameInfo* to_frame_info(uint32 physical_address)
 
 void	tlb_invalidate(uint32 *pgdir, void *ptr);
 
+//***********************************
+//Live-PTE accounting of user page tables
+#define PTE_IS_LIVE(entry) (((entry) & (PERM_PRESENT | PERM_USER_MARKED)) != 0)
+
+void pt_update_live_count(uint32 *pgdir, uint32 virtual_address, uint32 old_entry, uint32 new_entry);
+uint32 pt_live_count(uint32 *pgdir, uint32 virtual_address);
+
+//***********************************
+//TLB flush batching: range operations (env_free, free_user_mem, kfree, ...)
+//collect the VAs they touch and flush once at the end instead of issuing one
+//invlpg per page. Above TLB_BATCH_MAX pages a full CR3 reload is cheaper.
+#define TLB_BATCH_MAX 32
+
+struct tlb_batch
+{
+	uint32 *pgdir;			// address space the entries belong to
+	uint32 count;			// # of VAs collected so far
+	uint8 flush_all;		// set when count overflows TLB_BATCH_MAX
+	uint32 vas[TLB_BATCH_MAX];
+};
+
+void tlb_batch_init(struct tlb_batch *batch, uint32 *pgdir);
+void tlb_batch_add(struct tlb_batch *batch, uint32 virtual_address);
+void tlb_batch_flush(struct tlb_batch *batch);
+void unmap_frame_batched(uint32 *pgdir, uint32 virtual_address, struct tlb_batch *batch);
+
+//***********************************
+//Pre-zeroed frames: the scheduler zeroes free frames while it is idle so that
+//allocate_zeroed_frame() doesn't have to memset on the allocation/fault path
+#define ZEROED_FRAMES_POOL_SIZE	64	// max # of frames kept pre-zeroed
+#define ZEROED_FRAMES_PER_IDLE	8	// max # of frames zeroed per idle pass
+
+struct zeroedFramesCounters
+{
+	uint32 hits;			// allocations served from the pool (zeroing moved off the critical path)
+	uint32 misses;			// allocations that found the pool empty & zeroed in place
+	uint32 zeroedWhenIdle;	// frames zeroed by refill_zeroed_frames()
+} zeroed_frames_counters;
+
+int allocate_zeroed_frame(struct FrameInfo **ptr_frame_info);
+uint32 refill_zeroed_frames(uint32 max_frames);
+
 struct freeFramesCounters calculate_available_frames();
 
 void __static_cpt(uint32 *ptr_directory, const uint32 virtual_address, uint32 **ptr_page_table);
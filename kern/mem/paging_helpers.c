@@ -8,6 +8,13 @@
 
 /*[2.1] PAGE TABLE ENTRIES MANIPULATION */
 void pt_set_page_permissions(uint32* page_directory, uint32 virtual_address, uint32 permissions_to_set, uint32 permissions_to_clear)
+{
+	pt_set_page_permissions_batched(page_directory, virtual_address, permissions_to_set, permissions_to_clear, NULL);
+}
+
+// Same as pt_set_page_permissions(), but when 'batch' is not NULL the TLB
+// invalidation is deferred to tlb_batch_flush(batch).
+void pt_set_page_permissions_batched(uint32* page_directory, uint32 virtual_address, uint32 permissions_to_set, uint32 permissions_to_clear, struct tlb_batch *batch)
 {
 	//[1] Get the table
 	uint32* ptr_page_table ;
@@ -16,8 +23,10 @@ void pt_set_page_permissions(uint32* page_directory, uint32 virtual_address, uin
 	//[2] If exists, update permissions
 	if (ptr_page_table != NULL)
 	{
+		uint32 old_entry = ptr_page_table[PTX(virtual_address)];
 		ptr_page_table[PTX(virtual_address)] |= (permissions_to_set);
 		ptr_page_table[PTX(virtual_address)] &= (~permissions_to_clear);
+		pt_update_live_count(page_directory, virtual_address, old_entry, ptr_page_table[PTX(virtual_address)]);
 
 	}
 	//[3] Else, should "panic" since the table should be exist
@@ -29,7 +38,10 @@ void pt_set_page_permissions(uint32* page_directory, uint32 virtual_address, uin
 	}
 
 	//[4] Invalidate the cache memory (TLB) [call tlb_invalidate(..)]
-	tlb_invalidate((void *)NULL, (void *)virtual_address);
+	if (batch != NULL)
+		tlb_batch_add(batch, virtual_address);
+	else
+		tlb_invalidate((void *)NULL, (void *)virtual_address);
 }
 
 int pt_get_page_permissions(uint32* page_directory, uint32 virtual_address )
@@ -62,6 +74,7 @@ void pt_clear_page_table_entry(uint32* page_directory, uint32 virtual_address)
 	if (ptr_page_table != NULL)
 	{
 		cprintf("va=%x before clearing has perm = %x\n", virtual_address, ptr_page_table[PTX(virtual_address)]);
+		pt_update_live_count(page_directory, virtual_address, ptr_page_table[PTX(virtual_address)], 0);
 		ptr_page_table[PTX(virtual_address)] = 0;
 	}
 	//[3] Else, should "panic" since the table should be exist
@@ -8,9 +8,12 @@
 #ifndef KERN_MEM_PAGING_HELPERS_H_
 #define KERN_MEM_PAGING_HELPERS_H_
 
+struct tlb_batch;
+
 /*[2.1] PAGE TABLE ENTRIES MANIPULATION */
 void pt_clear_page_table_entry(uint32* page_directory, uint32 virtual_address);
 void pt_set_page_permissions(uint32* page_directory, uint32 virtual_address, uint32 permissions_to_set, uint32 permissions_to_clear);
+void pt_set_page_permissions_batched(uint32* page_directory, uint32 virtual_address, uint32 permissions_to_set, uint32 permissions_to_clear, struct tlb_batch *batch);
 int pt_get_page_permissions(uint32* page_directory, uint32 virtual_address );
 
 
@@ -16,9 +16,9 @@
 #include "memory_manager.h"
 
 static struct FrameInfo* allocate_page(const struct Env* env, uint32 va , uint32 perm);
-static bool pt_is_page_empty(uint32* page_dir, uint32 va);
 
 void free_share(struct Share* ptrShare);
+static void destroy_share(struct Share* ptrShare);
 
 //==================================================================================//
 //============================== GIVEN FUNCTIONS ===================================//
@@ -28,17 +28,60 @@ struct Share* get_share(int32 ownerID, char* name);
 //===========================
 // [1] INITIALIZE SHARES:
 //===========================
-//Initialize the list and the corresponding lock
+//Initialize the hash table and the corresponding locks
 void sharing_init()
 {
 #if USE_KHEAP
-	LIST_INIT(&AllShares.shares_list) ;
+	for (int i = 0; i < SHARES_HASH_SIZE; i++)
+	{
+		LIST_INIT(&AllShares.buckets[i].shares);
+		init_spinlock(&AllShares.buckets[i].lk, "shares bucket lock");
+		AllShares.by_id[i] = NULL;
+	}
 	init_spinlock(&AllShares.shareslock, "shares lock");
 #else
 	panic("not handled when KERN HEAP is disabled");
 #endif
 }
 
+//2026: FNV-1a of the name (as stored in a share: at most 63 chars), seeded by the owner
+static struct share_bucket* share_bucket_of(int32 ownerID, char* name)
+{
+	uint32 h = 2166136261u ^ (uint32)ownerID;
+	for (int i = 0; i < sizeof(((struct Share*)0)->name) - 1 && name[i] != '\0'; i++)
+	{
+		h ^= (uint8)name[i];
+		h *= 16777619u;
+	}
+	return &AllShares.buckets[h & (SHARES_HASH_SIZE - 1)];
+}
+
+static inline uint32 share_id_hash(int32 ID)
+{
+	return ((uint32)ID * 2654435761u) >> (32 - SHARES_HASH_BITS);
+}
+
+//Search the given bucket (its lock should be held)
+static struct Share* share_bucket_find(struct share_bucket* b, int32 ownerID, char* name)
+{
+	struct Share* object = NULL;
+	LIST_FOREACH(object, &b->shares) {
+		if (object->ownerID == ownerID && strcmp(object->name, name) == 0) {
+			return object;
+		}
+	}
+	return NULL;
+}
+
+//Search by ID (AllShares.shareslock should be held)
+static struct Share* share_find_id(int32 ID)
+{
+	struct Share* object = AllShares.by_id[share_id_hash(ID)];
+	while (object != NULL && object->ID != ID)
+		object = object->id_next;
+	return object;
+}
+
 //==============================
 // [2] Get Size of Share Object:
 //==============================
@@ -146,25 +189,41 @@ struct Share* create_share(int32 ownerID, char* shareName, uint32 size, uint8 is
 struct Share* get_share(int32 ownerID, char* name)
 {
 	//TODO: [PROJECT'24.MS2 - #17] [4] SHARED MEMORY - get_share()
-	acquire_spinlock(&AllShares.shareslock);
+	//2026: only its bucket is searched
+	struct share_bucket* b = share_bucket_of(ownerID, name);
+	acquire_spinlock(&b->lk);
+	struct Share* object = share_bucket_find(b, ownerID, name);
+	release_spinlock(&b->lk);
 
-    struct Share* object = NULL;
-	bool found = 0;
-	LIST_FOREACH(object , &AllShares.shares_list) {
-		if (object->ownerID == ownerID && strcmp(object->name, name) == 0) {
-			found = 1;
-			break; 
-		}
+	return object;
+}
+
+//2026: Add the given share to the indices, unless its owner already has a
+//share of the same name
+//Return: 0 or E_SHARED_MEM_EXISTS
+static int insert_share(struct Env* owner, struct Share* ptrShare)
+{
+	struct share_bucket* b = share_bucket_of(ptrShare->ownerID, ptrShare->name);
+	acquire_spinlock(&AllShares.shareslock);
+	acquire_spinlock(&b->lk);
+	if (share_bucket_find(b, ptrShare->ownerID, ptrShare->name) != NULL) {
+		release_spinlock(&b->lk);
+		release_spinlock(&AllShares.shareslock);
+		return E_SHARED_MEM_EXISTS;
 	}
+	LIST_INSERT_TAIL(&b->shares, ptrShare);
+	release_spinlock(&b->lk);
 
-	release_spinlock(&AllShares.shareslock);
+	uint32 h = share_id_hash(ptrShare->ID);
+	ptrShare->id_next = AllShares.by_id[h];
+	AllShares.by_id[h] = ptrShare;
 
-	if (found == 1) {
-		return object;
-	}
-	else {
-		return NULL;
-	}
+	if ((ptrShare->owner_next = owner->shares) != NULL)
+		owner->shares->owner_pprev = &ptrShare->owner_next;
+	owner->shares = ptrShare;
+	ptrShare->owner_pprev = &owner->shares;
+	release_spinlock(&AllShares.shareslock);
+	return 0;
 }
 
 //=========================
@@ -203,23 +262,25 @@ int createSharedObject(int32 ownerID, char* shareName, uint32 size, uint8 isWrit
 		}
 
 		share_obj->framesStorage[i] = frame_info;
+		//2026: mark it so that fork keeps it shared, and to key futexes in O(1)
+		frame_info->isShared = 1;
+		frame_info->shareID = share_obj->ID;
+		frame_info->sharePage = i;
 	}
 
-	if (allocation_failed) {
-		free_share(share_obj);
+	// 2026: the name may have been taken meanwhile
+	int ret = allocation_failed ? E_NO_SHARE : insert_share(myenv, share_obj);
+	if (ret != 0) {
+		destroy_share(share_obj);
 
 		// Release allocated frames
 		for (uint32 v = (uint32) virtual_address; v < va; v += PAGE_SIZE) {
 			unmap_frame(myenv->env_page_directory, v);
 		}
 
-		return E_NO_SHARE;
+		return ret;
 	}
 
-	acquire_spinlock(&AllShares.shareslock);
-	LIST_INSERT_TAIL(&AllShares.shares_list, share_obj);
-	release_spinlock(&AllShares.shareslock);
-
 	return share_obj->ID;
 }
 
@@ -245,7 +306,14 @@ int getSharedObject(int32 ownerID, char* shareName, void* virtual_address)
 	//COMMENT THE FOLLOWING LINE BEFORE START CODING
 	// panic("getSharedObject is not implemented yet");
 	struct Env* myenv = get_cpu_proc(); //The calling environment
-	struct Share *shared_obj = get_share(ownerID, shareName);
+	//2026: referenced while its bucket is locked: it can't be freed meanwhile
+	struct share_bucket* b = share_bucket_of(ownerID, shareName);
+	acquire_spinlock(&b->lk);
+	struct Share *shared_obj = share_bucket_find(b, ownerID, shareName);
+	if (shared_obj) {
+		shared_obj->references++;
+	}
+	release_spinlock(&b->lk);
 	if(!shared_obj){
 		return E_SHARED_MEM_NOT_EXISTS;
 	}
@@ -258,11 +326,35 @@ int getSharedObject(int32 ownerID, char* shareName, void* virtual_address)
 		map_frame(myenv->env_page_directory, frame, (uint32)virtual_address, perm);
 	}
 
-	shared_obj->references++;
-
 	return shared_obj->ID;
 }
 
+//2026
+//=================================
+// [6] Key of an Address in a Share:
+//=================================
+//Identify the word at the given VA of the given env by (shared object, offset
+//inside it), which is the same in all the envs sharing it whatever its VA there.
+//It's read from the frame (see createSharedObject()): no lock, no search
+//RETURN:
+//	0 if success
+//	E_SHARED_MEM_NOT_EXISTS if the VA is not in a shared object
+int getSharedObjectKey(struct Env* env, uint32 virtual_address, int32* sharedObjectID, uint32* offset)
+{
+	uint32 *ptr_page_table = NULL;
+	struct FrameInfo* frame = get_frame_info(env->env_page_directory, virtual_address, &ptr_page_table);
+	if (frame == NULL)
+		return E_SHARED_MEM_NOT_EXISTS;
+
+	int32 ID = frame->shareID;
+	if (ID == 0)
+		return E_SHARED_MEM_NOT_EXISTS;
+
+	*sharedObjectID = ID;
+	*offset = frame->sharePage * PAGE_SIZE + PGOFF(virtual_address);
+	return 0;
+}
+
 //==================================================================================//
 //============================== BONUS FUNCTIONS ===================================//
 //==================================================================================//
@@ -270,7 +362,7 @@ int getSharedObject(int32 ownerID, char* shareName, void* virtual_address)
 //==========================
 // [B1] Delete Share Object:
 //==========================
-//delete the given shared object from the "shares_list"
+//delete the given shared object from the indices (AllShares.shareslock should be held)
 //it should free its framesStorage and the share object itself
 void free_share(struct Share* ptrShare)
 {
@@ -280,15 +372,64 @@ void free_share(struct Share* ptrShare)
 	//Your Code is Here...
 
 	assert(ptrShare);
+	assert(holding_spinlock(&AllShares.shareslock));
 
-	acquire_spinlock(&AllShares.shareslock);
-	// Should do nothing, if `ptrShare` is not in the list
-	LIST_REMOVE(&AllShares.shares_list, ptrShare);
-	release_spinlock(&AllShares.shareslock);
-	
+	struct share_bucket* b = share_bucket_of(ptrShare->ownerID, ptrShare->name);
+	acquire_spinlock(&b->lk);
+	LIST_REMOVE(&b->shares, ptrShare);
+	release_spinlock(&b->lk);
+
+	struct Share** pp = &AllShares.by_id[share_id_hash(ptrShare->ID)];
+	while (*pp != ptrShare)
+		pp = &(*pp)->id_next;
+	*pp = ptrShare->id_next;
+
+	if ((*ptrShare->owner_pprev = ptrShare->owner_next) != NULL)
+		ptrShare->owner_next->owner_pprev = ptrShare->owner_pprev;
+
+	destroy_share(ptrShare);
+}
+
+//2026: free a share that is not (or no more) in the indices
+static void destroy_share(struct Share* ptrShare)
+{
+	//its frames that are still mapped somewhere don't belong to it anymore
+	uint32 number_of_frames = ROUNDUP(ptrShare->size, PAGE_SIZE) / PAGE_SIZE;
+	for (uint32 i = 0; i < number_of_frames; i++) {
+		struct FrameInfo* frame = ptrShare->framesStorage[i];
+		if (frame != NULL && frame->shareID == ptrShare->ID)
+			frame->shareID = 0;
+	}
 	kfree(ptrShare->framesStorage);
 	kfree(ptrShare);
 }
+
+//2026: Called by env_free(): delete ALL shared objects created by the given
+//env, walking its own list only
+void sharing_env_free(struct Env* e)
+{
+	acquire_spinlock(&AllShares.shareslock);
+	while (e->shares != NULL) {
+		free_share(e->shares);
+	}
+	release_spinlock(&AllShares.shareslock);
+}
+
+//2026: Called by env_fork() for each mapping of a share the child inherits:
+//it references the share like a getSharedObject() would
+void sharing_add_reference(int32 sharedObjectID)
+{
+	acquire_spinlock(&AllShares.shareslock);
+	struct Share* share_obj = share_find_id(sharedObjectID);
+	if (share_obj) {
+		struct share_bucket* b = share_bucket_of(share_obj->ownerID, share_obj->name);
+		acquire_spinlock(&b->lk);
+		share_obj->references++;
+		release_spinlock(&b->lk);
+	}
+	release_spinlock(&AllShares.shareslock);
+}
+
 //========================
 // [B2] Free Share Object:
 //========================
@@ -298,42 +439,42 @@ int freeSharedObject(int32 sharedObjectID, void *startVA)
 	//COMMENT THE FOLLOWING LINE BEFORE START CODING
 	// panic("freeSharedObject is not implemented yet");
 	//Your Code is Here...
-	struct Share* share_obj = NULL;
-
 	acquire_spinlock(&AllShares.shareslock);
-	bool found = 0;
-	LIST_FOREACH(share_obj, &AllShares.shares_list) {
-		if (share_obj->ID == sharedObjectID) { 
-			found = 1;
-			break;
+	struct Share* share_obj = share_find_id(sharedObjectID);
+	uint32 size = 0;
+	if (share_obj) {
+		//2026: its references are changed under its bucket lock (see getSharedObject)
+		size = share_obj->size;
+		struct share_bucket* b = share_bucket_of(share_obj->ownerID, share_obj->name);
+		acquire_spinlock(&b->lk);
+		uint32 references = --share_obj->references;
+		release_spinlock(&b->lk);
+		if (references == 0) {
+			free_share(share_obj);
 		}
 	}
 	release_spinlock(&AllShares.shareslock);
-	
 
-	if (!found) {
+	if (!share_obj) {
 		return -1;
 	}
 
 	struct Env* myenv = get_cpu_proc();
 	uint32 start_va = ROUNDDOWN((uint32) startVA, PAGE_SIZE);
-	uint32 end_va = start_va + ROUNDUP(share_obj->size, PAGE_SIZE);
+	uint32 end_va = start_va + ROUNDUP(size, PAGE_SIZE);
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, myenv->env_page_directory);
 	for (uint32 va = start_va; va < end_va; va += PAGE_SIZE) {
 		uint32* page_table = NULL;
 		get_page_table(myenv->env_page_directory, va, &page_table);
 
-		unmap_frame(myenv->env_page_directory, va);
-		if (pt_is_page_empty(myenv->env_page_directory, va)) {
+		unmap_frame_batched(myenv->env_page_directory, va, &batch);
+		if (page_table != NULL && pt_live_count(myenv->env_page_directory, va) == 0) {
 			pd_clear_page_dir_entry(myenv->env_page_directory, va);
 			kfree(page_table);
 		}
 	}
-	share_obj->references--;
-	if (share_obj->references == 0) {
-		free_share(share_obj);
-	}
-
-	tlbflush();
+	tlb_batch_flush(&batch);
 
 	return 0;
 }
@@ -369,21 +510,3 @@ allocate_page(const struct Env* env, uint32 va , uint32 perm)
 	return frame_info;
 }
 
-static bool
-pt_is_page_empty(uint32* page_dir, uint32 va) {
-	uint32* page_table = NULL;
-	get_page_table(page_dir, va, &page_table);
-	if (!page_table) {
-		return 1;
-	}
-
-	uint32* end_va = (void*) page_table + PAGE_SIZE;
-	for (uint32* va = page_table; va < end_va; va++) {
-		int32 perm = *va;
-		if ((perm & PERM_PRESENT) || (perm & PERM_USER_MARKED)) {
-			return 0;
-		}
-	}
-
-	return 1;
-}
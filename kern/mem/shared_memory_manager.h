@@ -32,8 +32,12 @@ struct Share
 	struct FrameInfo** framesStorage;
 
 	// list link pointers
-	LIST_ENTRY(Share) prev_next_info;
+	LIST_ENTRY(Share) prev_next_info;	//2026: link in its bucket of AllShares.buckets
 
+	//2026: the other indices (protected by AllShares.shareslock)
+	struct Share *id_next;			//next share in its bucket of AllShares.by_id
+	struct Share *owner_next;		//next share of the same owner (list of Env::shares)
+	struct Share **owner_pprev;		//pointer to this share in that list
 };
 
 //List of all shared objects
@@ -44,19 +48,34 @@ LIST_HEAD(Share_List, Share);		// Declares 'struct Share_List'
 	#define MAX_SHARES 100
 	struct Share shares[MAX_SHARES] ;
 #else
+	//2026: shares are hashed by (ownerID, name), each bucket with its own
+	//lock: looking a share up by name takes its bucket lock only
+	#define SHARES_HASH_BITS	8
+	#define SHARES_HASH_SIZE	(1 << SHARES_HASH_BITS)
+
+	struct share_bucket
+	{
+		struct spinlock lk;
+		struct Share_List shares;
+	};
+
 	struct
 	{
-		struct Share_List shares_list ;	//List of all share variables created by any process
-		struct spinlock shareslock;		//Use it to protect the shares_list in the kernel
+		struct share_bucket buckets[SHARES_HASH_SIZE];	//All share variables created by any process, by (ownerID, name)
+		struct Share *by_id[SHARES_HASH_SIZE];			//The same, by ID
+		struct spinlock shareslock;		//Protects by_id & the lists of shares of each owner, taken before a bucket lock
 	}AllShares;
 
 	void sharing_init();
+	void sharing_env_free(struct Env* e);	//2026
+	void sharing_add_reference(int32 sharedObjectID);	//2026
 #endif
 
 int createSharedObject(int32 ownerID, char* shareName, uint32 size, uint8 isWritable, void* virtual_address);
 int getSizeOfSharedObject(int32 ownerID, char* shareName);
 int getSharedObject(int32 ownerID, char* shareName, void* virtual_address);
 int freeSharedObject(int32 sharedObjectID, void *startVA);
+int getSharedObjectKey(struct Env* env, uint32 virtual_address, int32* sharedObjectID, uint32* offset);	//2026
 
 
 #endif /* FOS_SHARED_MEMORY_MANAGER_H */
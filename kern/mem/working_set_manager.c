@@ -27,9 +27,141 @@ struct WorkingSetElement* env_page_ws_list_create_element(struct Env* e, uint32
 	return new_element;
 }
 
+//Linear lookup, for frames that have no owning WS element (e.g. shared by fork)
+struct WorkingSetElement* env_page_ws_list_find_element(struct Env* e, uint32 virtual_address)
+{
+	struct WorkingSetElement *wse = NULL;
+	LIST_FOREACH(wse, &(e->page_WS_list))
+	{
+		if (ROUNDDOWN(wse->virtual_address, PAGE_SIZE) == ROUNDDOWN(virtual_address, PAGE_SIZE))
+			return wse;
+	}
+	return NULL;
+}
+
+//2026: Add the page of the given VA (already mapped on the given frame) to the
+//WS (list or array) as the most recently placed page
+//Returns 0 if the WS is full
+int env_page_ws_add(struct Env* e, uint32 virtual_address, struct FrameInfo *frame)
+{
+	if (e->page_WS_array != NULL)
+	{
+		if (e->page_WS_array_size >= e->page_WS_max_size)
+			return 0;
+		env_page_ws_array_insert(e, virtual_address, frame);
+		return 1;
+	}
+
+	if (LIST_SIZE(&(e->page_WS_list)) >= e->page_WS_max_size)
+		return 0;
+	struct WorkingSetElement *new_element = env_page_ws_list_create_element(e, virtual_address);
+	// Added to implement O(1) free_user_mem
+	frame->wse = new_element;
+	frame->wse_dir = e->env_page_directory;
+
+	if (e->page_last_WS_element == NULL) {
+		LIST_INSERT_TAIL(&(e->page_WS_list), new_element);
+		if(LIST_SIZE(&(e->page_WS_list)) == e->page_WS_max_size) {
+			e->page_last_WS_element = LIST_FIRST(&(e->page_WS_list));
+		}
+	} else {
+		LIST_INSERT_BEFORE(&(e->page_WS_list), e->page_last_WS_element, new_element);
+	}
+	return 1;
+}
+
+//=====================================
+// COMPACT WS ARRAY (2026):
+//=====================================
+//Move the WS list of the given env (as built by env_create) into a contiguous
+//array of page_WS_max_size compact entries. From now on, the env's WS is kept
+//there: the replacement scans sweep the array linearly instead of chasing the
+//kmalloc'd list nodes. page_last_WS_index is its clock hand.
+void env_page_ws_array_create(struct Env* e)
+{
+	struct WSArrayEntry *ws = (struct WSArrayEntry*)kmalloc(e->page_WS_max_size * sizeof(struct WSArrayEntry));
+	if (ws == NULL) {
+		panic("working_set_manager.c::env_page_ws_array_create(), Failed to create the WS array");
+	}
+	memset(ws, 0, e->page_WS_max_size * sizeof(struct WSArrayEntry));
+
+	uint32 i = 0;
+	e->page_last_WS_index = 0;
+	while (!LIST_EMPTY(&(e->page_WS_list)))
+	{
+		struct WorkingSetElement *wse = LIST_FIRST(&(e->page_WS_list));
+		if (wse == e->page_last_WS_element)
+			e->page_last_WS_index = i;
+		WSA_SET(&ws[i], wse->virtual_address, wse->sweeps_counter);
+		ws[i].time_stamp = wse->time_stamp;
+		uint32 *page_table = NULL;
+		struct FrameInfo *frame = get_frame_info(e->env_page_directory, wse->virtual_address, &page_table);
+		if (frame != NULL && frame->wse == wse)
+		{
+			frame->wse = NULL;
+			frame->ws_index = i;
+		}
+		i++;
+
+		LIST_REMOVE(&(e->page_WS_list), wse);
+		kfree(wse);
+	}
+	e->page_last_WS_element = NULL;
+	e->page_WS_array_size = i;
+	e->page_WS_array = ws;
+}
+
+//Place the given VA (mapped on the given frame) in the first free entry at/after
+//the clock hand. The frame keeps the index of that entry.
+void env_page_ws_array_insert(struct Env* e, uint32 virtual_address, struct FrameInfo *frame)
+{
+	uint32 max_size = e->page_WS_max_size;
+	for (uint32 k = 0, i = e->page_last_WS_index; k < max_size; k++, i = (i + 1 == max_size) ? 0 : i + 1)
+	{
+		if (!WSA_IS_VALID(&(e->page_WS_array[i])))
+		{
+			WSA_SET(&(e->page_WS_array[i]), virtual_address, 0);
+			e->page_WS_array[i].time_stamp = 0;
+			e->page_WS_array_size++;
+			frame->wse_dir = e->env_page_directory;
+			frame->ws_index = i;
+			return;
+		}
+	}
+	panic("working_set_manager.c::env_page_ws_array_insert(), WS array is full");
+}
+
+//Return the index of the entry of the given VA, or -1 if it's not in the WS
+int env_page_ws_array_find(struct Env* e, uint32 virtual_address)
+{
+	uint32 va_bits = ROUNDDOWN(virtual_address, PAGE_SIZE) | WSA_VALID;
+	for (uint32 i = 0; i < e->page_WS_max_size; i++)
+	{
+		if ((e->page_WS_array[i].va_sweeps & (~0xFFF | WSA_VALID)) == va_bits)
+			return i;
+	}
+	return -1;
+}
+
+void env_page_ws_array_clear(struct Env* e, uint32 entry_index)
+{
+	e->page_WS_array[entry_index].va_sweeps = 0;
+	e->page_WS_array[entry_index].time_stamp = 0;
+	e->page_WS_array_size--;
+}
+
 void env_page_ws_invalidate(struct Env* e, uint32 virtual_address)
 {
-	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+	if (e->page_WS_array != NULL)
+	{
+		int i = env_page_ws_array_find(e, virtual_address);
+		if (i >= 0)
+		{
+			unmap_frame(e->env_page_directory, WSA_VA(&(e->page_WS_array[i])));
+			env_page_ws_array_clear(e, i);
+		}
+	}
+	else if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
 	{
 		bool found = 0;
 		struct WorkingSetElement *ptr_WS_element = NULL;
@@ -94,6 +226,46 @@ void env_page_ws_invalidate(struct Env* e, uint32 virtual_address)
 		}
 	}
 }
+
+//2026: Make the WS entry of the page moved from src_va to dst_va (on the given
+//frame, by move_user_mem()) refer to dst_va. O(1) through the frame if this
+//env owns its WS entry, otherwise (frame shared by fork) the WS is searched
+void env_page_ws_move(struct Env* e, struct FrameInfo *frame, uint32 src_va, uint32 dst_va)
+{
+	bool owner = (frame->wse_dir == e->env_page_directory);
+	if (e->page_WS_array != NULL)
+	{
+		int i = owner ? (int)frame->ws_index : env_page_ws_array_find(e, src_va);
+		if (i >= 0)
+		{
+			struct WSArrayEntry *entry = &(e->page_WS_array[i]);
+			WSA_SET(entry, dst_va, WSA_SWEEPS(entry));
+		}
+		return;
+	}
+
+	struct WorkingSetElement *wse = owner ? frame->wse : NULL;
+	if (wse == NULL)
+	{
+		if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+		{
+			LIST_FOREACH(wse, &(e->ActiveList))
+				if (ROUNDDOWN(wse->virtual_address, PAGE_SIZE) == src_va)
+					break;
+			if (wse == NULL)
+			{
+				LIST_FOREACH(wse, &(e->SecondList))
+					if (ROUNDDOWN(wse->virtual_address, PAGE_SIZE) == src_va)
+						break;
+			}
+		}
+		else
+			wse = env_page_ws_list_find_element(e, src_va);
+	}
+	if (wse != NULL)
+		wse->virtual_address = wse->virtual_address - src_va + dst_va;
+}
+
 void env_page_ws_print(struct Env *e)
 {
 	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
@@ -111,6 +283,30 @@ void env_page_ws_print(struct Env *e)
 			cprintf("%d:	%x\n", i++, ptr_WS_element->virtual_address);
 		}
 	}
+	else if (e->page_WS_array != NULL)
+	{
+		cprintf("PAGE WS (array):\n");
+		for (uint32 i = 0; i < e->page_WS_max_size; ++i)
+		{
+			struct WSArrayEntry *entry = &(e->page_WS_array[i]);
+			if (!WSA_IS_VALID(entry))
+			{
+				cprintf("EMPTY LOCATION");
+			}
+			else
+			{
+				uint32 perm = pt_get_page_permissions(e->env_page_directory, WSA_VA(entry)) ;
+				cprintf("%d: %x, used= %d, modified= %d, buffered= %d, time stamp= %x, sweeps_cnt= %d",
+						i, WSA_VA(entry), (perm&PERM_USED) ? 1 : 0, (perm&PERM_MODIFIED) ? 1 : 0,
+						(perm&PERM_BUFFERED) ? 1 : 0, entry->time_stamp, WSA_SWEEPS(entry)) ;
+			}
+			if (i == e->page_last_WS_index)
+			{
+				cprintf(" <--");
+			}
+			cprintf("\n");
+		}
+	}
 	else
 	{
 		uint32 i=0;
@@ -13,10 +13,18 @@
 // Page WS helper functions ===================================================
 void env_page_ws_print(struct Env *curenv);
 void env_page_ws_invalidate(struct Env* e, uint32 virtual_address);
+void env_page_ws_move(struct Env* e, struct FrameInfo *frame, uint32 src_va, uint32 dst_va);	//2026
 
 #if USE_KHEAP
 /*2024*/
 struct WorkingSetElement* env_page_ws_list_create_element(struct Env* e, uint32 virtual_address);
+struct WorkingSetElement* env_page_ws_list_find_element(struct Env* e, uint32 virtual_address);
+int env_page_ws_add(struct Env* e, uint32 virtual_address, struct FrameInfo *frame);	//2026
+/*2026: compact WS array*/
+void env_page_ws_array_create(struct Env* e);
+void env_page_ws_array_insert(struct Env* e, uint32 virtual_address, struct FrameInfo *frame);
+int env_page_ws_array_find(struct Env* e, uint32 virtual_address);
+void env_page_ws_array_clear(struct Env* e, uint32 entry_index);
 #else
 uint32 env_page_ws_get_size(struct Env *e);
 void env_page_ws_set_entry(struct Env* e, uint32 entry_index, uint32 virtual_address);
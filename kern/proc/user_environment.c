@@ -19,6 +19,8 @@
 #include "../mem/kheap.h"
 #include "../mem/memory_manager.h"
 #include "../mem/shared_memory_manager.h"
+#include "../cpu/ktimer.h"
+#include "../conc/ipc.h"
 
 
 /******************************/
@@ -71,6 +73,10 @@ static int program_segment_alloc_map_copy_workingset(struct Env *e, struct Progr
 void initialize_environment(struct Env* e, uint32* ptr_user_page_directory, unsigned int phys_user_page_directory);
 void complete_environment_initialization(struct Env* e);
 void set_environment_entry_point(struct Env* e, uint8* ptr_program_start);
+static void clone_address_space_cow(struct Env* parent, struct Env* child);
+#if USE_KHEAP
+static int clone_ws_list(struct Env* child, struct Env* parent);
+#endif
 
 ///=========================================================
 
@@ -335,12 +341,9 @@ struct Env* env_create(char* user_program_name, unsigned int page_WS_size, unsig
 		{
 			//allocate and map
 			struct FrameInfo *pp = NULL;
-			allocate_frame(&pp);
+			allocate_zeroed_frame(&pp);
 			loadtime_map_frame(e->env_page_directory, pp, stackVa, PERM_USER | PERM_WRITEABLE);
 
-			//initialize new page by 0's
-			memset((void*)stackVa, 0, PAGE_SIZE);
-
 			//now add it to the working set and the page table
 			{
 #if USE_KHEAP
@@ -412,6 +415,14 @@ struct Env* env_create(char* user_program_name, unsigned int page_WS_size, unsig
 			}
 		}
 
+#if USE_KHEAP
+		//2026: keep the WS in a compact array instead (not for the LRU lists)
+		if (isWSArrayEnabled() && !isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+		{
+			env_page_ws_array_create(e);
+		}
+#endif
+
 		///[11] switch back to the page directory exists before segment loading
 		lcr3(cur_phys_pgdir) ;
 	}
@@ -489,79 +500,72 @@ void env_free(struct Env *e)
 		return;
 	}
 
-	struct WorkingSetElement *working_set_element_iterator = NULL;
-	uint32 *ptr_page_table;
-	uint8 is_empty;
-
-	// All pages in the page working set
+	// Working set itself (the mapped pages are released with their tables below)
 	while (!LIST_EMPTY(&(e->page_WS_list))){
-
-		working_set_element_iterator = LIST_FIRST(&(e->page_WS_list));
-
-		ptr_page_table = NULL;
-		is_empty = 1;
-
-		get_page_table(e->env_page_directory, working_set_element_iterator->virtual_address, &ptr_page_table);
-
-		unmap_frame(e->env_page_directory, working_set_element_iterator->virtual_address);
-		pt_clear_page_table_entry(e->env_page_directory, working_set_element_iterator->virtual_address);
-
-		for (int page_table_index = 0; page_table_index < 1024; page_table_index++) {
-			if (ptr_page_table[page_table_index] != 0) {
-				is_empty = 0;
-				break;
-			}
-		}
-
-		if (is_empty) {
-			pd_clear_page_dir_entry(e->env_page_directory, (uint32)ptr_page_table);
-			kfree((void *)ptr_page_table);
-		}
-
+		struct WorkingSetElement *working_set_element_iterator = LIST_FIRST(&(e->page_WS_list));
 		LIST_REMOVE(&(e->page_WS_list), working_set_element_iterator);
 		kfree(working_set_element_iterator);
 	}
-
-
-	// free any remaining pages that was not in the working set
-	ptr_page_table = NULL;
-	for (uint32 virtual_address = USER_HEAP_START; virtual_address < USER_HEAP_MAX; virtual_address += PAGE_SIZE){
-		if(get_page_table(e->env_page_directory, virtual_address, &ptr_page_table) == TABLE_IN_MEMORY){
-			unmap_frame(e->env_page_directory, virtual_address);
-			// pt_clear_page_table_entry(e->env_page_directory, virtual_address);
-		}
+	e->page_last_WS_element = NULL;
+	//2026: and its LRU lists
+	while (!LIST_EMPTY(&(e->ActiveList))){
+		struct WorkingSetElement *wse = LIST_FIRST(&(e->ActiveList));
+		LIST_REMOVE(&(e->ActiveList), wse);
+		kfree(wse);
+	}
+	while (!LIST_EMPTY(&(e->SecondList))){
+		struct WorkingSetElement *wse = LIST_FIRST(&(e->SecondList));
+		LIST_REMOVE(&(e->SecondList), wse);
+		kfree(wse);
+	}
+	//2026: its timer must not fire after it's gone
+	ktimer_cancel(&e->sleep_timer);
+	//2026: its blocked senders give up
+	ipc_env_free(e);
+	if (e->page_WS_array != NULL)
+	{
+		kfree(e->page_WS_array);
+		e->page_WS_array = NULL;
+		e->page_WS_array_size = 0;
 	}
 
-	// check for any remaining page tables
-	ptr_page_table = NULL;
-	for (uint32 page_table_virtual_address = USER_HEAP_START; page_table_virtual_address < USER_HEAP_MAX; page_table_virtual_address += PAGE_SIZE * 1024){
-
-		if(get_page_table(e->env_page_directory, page_table_virtual_address, &ptr_page_table) == TABLE_IN_MEMORY){
-
-			pd_clear_page_dir_entry(e->env_page_directory, (uint32)ptr_page_table);
-			kfree((void*)ptr_page_table);
+	// All pages & page tables in the entire user virtual memory:
+	// walk the present directory entries only, and stop scanning a table
+	// as soon as all of its live entries are released.
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, e->env_page_directory);
+
+	for (uint32 pdx = 0; pdx < PDX(USER_TOP); pdx++){
+		if ((e->env_page_directory[pdx] & PERM_PRESENT) != PERM_PRESENT)
+			continue;
+
+		uint32 table_va = (uint32)PGADDR(pdx, 0, 0);
+		uint32 *ptr_page_table = NULL;
+		get_page_table(e->env_page_directory, table_va, &ptr_page_table);
+
+		uint32 live_ptes = pt_live_count(e->env_page_directory, table_va);
+		for (uint32 ptx = 0; ptx < NPTENTRIES && live_ptes > 0; ptx++){
+			uint32 entry = ptr_page_table[ptx];
+			if (!PTE_IS_LIVE(entry))
+				continue;
+			live_ptes--;
+			if (entry & PERM_PRESENT)
+				unmap_frame_batched(e->env_page_directory, (uint32)PGADDR(pdx, ptx, 0), &batch);
 		}
+
+		e->env_page_directory[pdx] = 0;
+		kfree((void *)ptr_page_table);
 	}
 
+	// directory entries were dropped as well: one full flush covers everything
+	batch.flush_all = 1;
+	tlb_batch_flush(&batch);
+
 	// remove the User kernel stack
 	delete_user_kern_stack(e);
 
 	// ALL shared objects (if any) & ALL semaphores (if any)
-	acquire_spinlock(&(AllShares.shareslock));
-	struct Share *share_list_iterator = NULL;
-
-	LIST_FOREACH(share_list_iterator, &(AllShares.shares_list)){
-
-		if(share_list_iterator->ownerID == e->env_id){
-
-			LIST_REMOVE(&AllShares.shares_list, share_list_iterator);
-
-			kfree(share_list_iterator->framesStorage);
-			kfree(share_list_iterator);
-		}
-	}
-
-	release_spinlock(&(AllShares.shareslock));
+	sharing_env_free(e);
 
 	// free the Directory table
 	kfree(e->env_page_directory);
@@ -575,7 +579,6 @@ void env_free(struct Env *e)
 	/*(ALREADY DONE for you)*/
 	free_environment(e); /*(ALREADY DONE for you)*/ // (frees the environment (returns it back to the free environment list))
 	/*========================*/
-	cprintf("\n old_brk: %x, new_brk: %x\n", old_brk, kheap_break);
 }
 
 //============================
@@ -761,6 +764,71 @@ void switchuvm(struct Env *proc)
 	popcli();	//enable interrupt
 }
 
+//===============================
+// 11) FORK AN ENV:
+//===============================
+// Create a child of "parent" that shares all of its memory pages copy-on-write
+// and all of its page file pages by reference (nothing is reloaded or copied).
+// The child resumes from a copy of the parent's trap frame with 0 as the
+// return value of the fork syscall. It is created with status = NEW.
+// Returns NULL if there's no free env.
+struct Env* env_fork(struct Env* parent)
+{
+	struct Env* e = NULL;
+	if(allocate_environment(&e) < 0)
+	{
+		return NULL;
+	}
+	strcpy(e->prog_name, parent->prog_name);
+
+	uint32* ptr_user_page_directory = create_user_directory();
+	unsigned int phys_user_page_directory = kheap_physical_address((uint32)ptr_user_page_directory);
+
+	e->page_WS_max_size = parent->page_WS_max_size;
+	e->SecondListSize = parent->SecondListSize;
+	e->ActiveListSize = parent->ActiveListSize;
+	e->percentage_of_WS_pages_to_be_removed = parent->percentage_of_WS_pages_to_be_removed;
+
+	initialize_environment(e, ptr_user_page_directory, phys_user_page_directory);
+
+	e->priority = parent->priority;
+	e->ready_queue = parent->ready_queue;
+	e->mlfq_epoch = parent->mlfq_epoch;
+	e->nice = parent->nice;
+	e->recent_cpu = parent->recent_cpu;
+	e->bsd_second = parent->bsd_second;
+	e->tickets = parent->tickets;
+	e->stride = parent->stride;
+	e->pass = parent->pass;
+	e->initNumStackPages = parent->initNumStackPages;
+	e->uheap_start = parent->uheap_start;
+	e->uheap_break = parent->uheap_break;
+	e->uheap_limit = parent->uheap_limit;
+
+	//Memory pages (copy-on-write) & working set
+	clone_address_space_cow(parent, e);
+#if USE_KHEAP
+	if (clone_ws_list(e, parent) != 0)
+	{
+		env_free(e);
+		return NULL;
+	}
+#endif
+
+	//Page file pages (shared by reference)
+	if (pf_clone_env(parent, e) != 0)
+	{
+		env_free(e);
+		return NULL;
+	}
+
+	//Resume exactly where the parent is, but see 0 as the fork result
+	*(e->env_tf) = *(parent->env_tf);
+	e->env_tf->tf_regs.reg_eax = 0;
+
+	return e;
+}
+
 
 //=================================================================================//
 //=============================== END MAIN FUNCTIONS ==============================//
@@ -1152,6 +1220,14 @@ void initialize_environment(struct Env* e, uint32* ptr_user_page_directory, unsi
 	e->nNotModifiedPages=0;
 	e->nClocks = 0;
 
+	//2026: scheduler accounting
+	e->sched_state = SCHED_ACCT_NONE;
+	e->sched_state_since = 0;
+	e->sched_ready_time = e->sched_run_time = e->sched_blocked_time = 0;
+	e->sched_max_ready_wait = 0;
+	e->nvcsw = e->nivcsw = 0;
+	memset(e->sched_wait_hist, 0, sizeof(e->sched_wait_hist));
+
 	//2020
 	e->nPageIn = 0;
 	e->nPageOut = 0;
@@ -1159,6 +1235,33 @@ void initialize_environment(struct Env* e, uint32* ptr_user_page_directory, unsi
 
 	// For priority promotion in priority scheduler MS3
 	e->age = 0;
+	e->ready_since = 0;
+	e->ready_queue = 0;
+	e->mlfq_epoch = mlfq_boost_epoch;
+
+	//2026: BSD scheduler (PRI_MAX with these values, i.e. ready queue 0)
+	e->nice = 0;
+	e->recent_cpu = fix_int(0);
+	e->bsd_second = bsd_seconds;
+	e->bsd_dirty = 0;
+
+	//2026: STRIDE scheduler
+	e->tickets = STRIDE_DEFAULT_TICKETS;
+	e->stride = STRIDE1 / STRIDE_DEFAULT_TICKETS;
+	e->pass = 0;
+	e->heap_index = -1;
+
+	//2026: timed sleep
+	e->sleep_timer.list = NULL;
+	e->sleep_timed_out = 0;
+
+	//2026: message passing
+	e->ipc_state = IPC_IDLE;
+	e->ipc_pages = NULL;
+	e->ipc_npages = 0;
+
+	//2026: shared objects
+	e->shares = NULL;
 
 	//e->shared_free_address = USER_SHARED_MEM_START;
 
@@ -1338,4 +1441,104 @@ void cleanup_buffers(struct Env* e)
 	//	cprintf("[%s] aft, mod = %d, fb = %d, fnb = %d\n",curenv->prog_name, ffc2.modified, ffc2.freeBuffered, ffc2.freeNotBuffered);
 }
 
+//========================================================
+// 14) CLONE ADDRESS SPACE & WS FOR FORK:
+//========================================================
+// Map every user page of "parent" into "child". Writable pages become
+// read-only + PERM_COW in both, so the first write on either side faults and
+// takes a private copy (see cow_fault_handler()).
+// Frames of shared objects (FrameInfo::isShared) stay shared as they are, and
+// each mapping of a share inherited by the child references it.
+static void clone_address_space_cow(struct Env* parent, struct Env* child)
+{
+	struct tlb_batch batch;
+	tlb_batch_init(&batch, parent->env_page_directory);
+
+	for (uint32 pdx = 0; pdx < PDX(USER_TOP); pdx++)
+	{
+		uint32 table_va = (uint32)PGADDR(pdx, 0, 0);
+		if (pt_live_count(parent->env_page_directory, table_va) == 0)
+			continue;
+
+		uint32 *parent_table = NULL;
+		get_page_table(parent->env_page_directory, table_va, &parent_table);
+		uint32 *child_table = create_page_table(child->env_page_directory, table_va);
+
+		for (uint32 ptx = 0; ptx < NPTENTRIES; ptx++)
+		{
+			uint32 entry = parent_table[ptx];
+			if (!PTE_IS_LIVE(entry))
+				continue;
 
+			uint32 va = (uint32)PGADDR(pdx, ptx, 0);
+			if (entry & PERM_PRESENT)
+			{
+				struct FrameInfo *ptr_frame_info = to_frame_info(EXTRACT_ADDRESS(entry));
+				uint8 is_shared_object = ptr_frame_info->isShared;
+				if ((entry & PERM_WRITEABLE) && !is_shared_object)
+				{
+					entry = (entry & ~PERM_WRITEABLE) | PERM_COW;
+					parent_table[ptx] = entry;
+					tlb_batch_add(&batch, va);
+				}
+				// a mapping of a share starts at its 1st page
+				if (is_shared_object && ptr_frame_info->sharePage == 0 && ptr_frame_info->shareID != 0)
+					sharing_add_reference(ptr_frame_info->shareID);
+				// its wse (if any) stays the parent's (see FrameInfo::wse_dir)
+				ptr_frame_info->references++;
+			}
+			child_table[ptx] = entry;
+			pt_update_live_count(child->env_page_directory, va, 0, entry);
+		}
+	}
+	tlb_batch_flush(&batch);
+}
+
+#if USE_KHEAP
+//Copy the elements of one WS list of the parent (in the same order) to "to".
+//The copy of "from_last" (if found) is returned in *to_last.
+//Returns E_NO_MEM if out of kernel heap (the copies made so far are in "to")
+static int clone_ws_list_elements(struct WS_List* to, struct WS_List* from, struct WorkingSetElement* from_last, struct WorkingSetElement** to_last)
+{
+	struct WorkingSetElement *wse;
+	LIST_FOREACH(wse, from)
+	{
+		struct WorkingSetElement *new_wse = (struct WorkingSetElement*)kmalloc(sizeof(struct WorkingSetElement));
+		if (new_wse == NULL)
+			return E_NO_MEM;
+		new_wse->virtual_address = wse->virtual_address;
+		new_wse->empty = wse->empty;
+		new_wse->time_stamp = wse->time_stamp;
+		new_wse->sweeps_counter = wse->sweeps_counter;
+		LIST_INSERT_TAIL(to, new_wse);
+		if (wse == from_last)
+			*to_last = new_wse;
+	}
+	return 0;
+}
+
+//Copy the WS (array, or list & LRU lists) of the parent to the child
+//Returns E_NO_MEM if out of kernel heap: env_free() the child then
+static int clone_ws_list(struct Env* child, struct Env* parent)
+{
+	if (parent->page_WS_array != NULL)
+	{
+		uint32 size = parent->page_WS_max_size * sizeof(struct WSArrayEntry);
+		child->page_WS_array = (struct WSArrayEntry*)kmalloc(size);
+		if (child->page_WS_array == NULL)
+			return E_NO_MEM;
+		memcpy(child->page_WS_array, parent->page_WS_array, size);
+		child->page_WS_array_size = parent->page_WS_array_size;
+		child->page_last_WS_index = parent->page_last_WS_index;
+		return 0;
+	}
+
+	struct WorkingSetElement *no_last = NULL;
+	child->page_last_WS_element = NULL;
+	if (clone_ws_list_elements(&(child->page_WS_list), &(parent->page_WS_list), parent->page_last_WS_element, &(child->page_last_WS_element)) != 0 ||
+		clone_ws_list_elements(&(child->ActiveList), &(parent->ActiveList), NULL, &no_last) != 0 ||
+		clone_ws_list_elements(&(child->SecondList), &(parent->SecondList), NULL, &no_last) != 0)
+		return E_NO_MEM;
+	return 0;
+}
+#endif
@@ -27,6 +27,8 @@ void env_init(void);
 struct Env* env_create(char* user_program_name, unsigned int page_WS_size, unsigned int LRU_second_list_size, unsigned int percent_WS_pages_to_remove);
 /*Free (delete) the environment by freeing its allocated memory and other resources (if any)*/
 void env_free(struct Env *e);
+/*Create a child of the given env sharing its memory copy-on-write and its page file pages*/
+struct Env* env_fork(struct Env* parent);
 
 ///===================================================================================
 /*2024*/
@@ -85,6 +85,15 @@ struct UserProgramInfo userPrograms[] = {
 		{ "sem1Slave", "[Slave program] of tst_semaphore_1master", PTR_START_OF(tst_semaphore_1slave)},
 		{ "tsem2", "Tests the Semaphores only [multiprograms enter the same CS]", PTR_START_OF(tst_semaphore_2master)},
 		{ "sem2Slave", "[Slave program] of tst_semaphore_2master", PTR_START_OF(tst_semaphore_2slave)},
+		{ "tfutex", "Tests the futex mutex & condition variable", PTR_START_OF(tst_futex_master)},
+		{ "futexSlave", "[Slave program] of tst_futex_master", PTR_START_OF(tst_futex_slave)},
+		{ "slplkSlave", "[Slave program] of the kernel sleep lock benchmark (tst slplk)", PTR_START_OF(tst_sleeplock_bench_slave)},
+		{ "tring", "Benchmarks the lock-free SPSC & MPMC ring buffers against semaphores", PTR_START_OF(tst_ring_bench_master)},
+		{ "ringSlave", "[Slave program] of tst_ring_bench_master", PTR_START_OF(tst_ring_bench_slave)},
+		{ "tipc", "Tests the message passing (value & zero-copy page transfer)", PTR_START_OF(tst_ipc_master)},
+		{ "ipcSlave", "[Slave program] of tst_ipc_master", PTR_START_OF(tst_ipc_slave)},
+		{ "trealloc", "Tests realloc (in place & by remapping the pages)", PTR_START_OF(tst_realloc)},
+		{ "tfork", "Tests fork: copy-on-write isolation & # frames taken by the copies", PTR_START_OF(tst_fork)},
 		{ "tff3", "tests first fit (3): malloc, smalloc & sget", PTR_START_OF(tst_first_fit_3)},
 
 		{ "tshr1", "Tests the shared variables [create]", PTR_START_OF(tst_sharing_1)},
@@ -120,6 +129,8 @@ struct UserProgramInfo userPrograms[] = {
 		{ "tshr5slave", "Slave program to be used with tshr5", PTR_START_OF(tst_sharing_5_slave)},
 		{ "tshr5slaveB1", "Slave program to be used with tshr5", PTR_START_OF(tst_sharing_5_slaveB1)},
 		{ "tshr5slaveB2", "Slave program to be used with tshr5", PTR_START_OF(tst_sharing_5_slaveB2)},
+		{ "tshr6", "Tests the lookup of many shared objects by name (hash table)", PTR_START_OF(tst_sharing_6)},
+		{ "tshr7", "Tests fork after createSharedObject: the object stays shared with the child", PTR_START_OF(tst_sharing_7)},
 		{ "tf3", "tests free (3): freeing buffers, tables, WS and page file [REplacement case]", PTR_START_OF(tst_free_3)},
 };
 
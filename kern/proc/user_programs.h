@@ -62,6 +62,15 @@ DECLARE_START_OF(tst_semaphore_1master);
 DECLARE_START_OF(tst_semaphore_1slave);
 DECLARE_START_OF(tst_semaphore_2master);
 DECLARE_START_OF(tst_semaphore_2slave);
+DECLARE_START_OF(tst_futex_master);
+DECLARE_START_OF(tst_futex_slave);
+DECLARE_START_OF(tst_sleeplock_bench_slave);
+DECLARE_START_OF(tst_ring_bench_master);
+DECLARE_START_OF(tst_ring_bench_slave);
+DECLARE_START_OF(tst_ipc_master);
+DECLARE_START_OF(tst_ipc_slave);
+DECLARE_START_OF(tst_realloc);
+DECLARE_START_OF(tst_fork);
 
 DECLARE_START_OF(tst_sharing_1);
 DECLARE_START_OF(tst_sharing_2master);
@@ -72,6 +81,8 @@ DECLARE_START_OF(tst_sharing_5_master);
 DECLARE_START_OF(tst_sharing_5_slave);
 DECLARE_START_OF(tst_sharing_5_slaveB1);
 DECLARE_START_OF(tst_sharing_5_slaveB2);
+DECLARE_START_OF(tst_sharing_6);
+DECLARE_START_OF(tst_sharing_7);
 
 DECLARE_START_OF(tst_air);
 DECLARE_START_OF(tst_air_clerk);
@@ -0,0 +1,116 @@
+/*
+ * test_chunk_ops.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <kern/tests/test_chunk_ops.h>
+
+#include <inc/memlayout.h>
+#include <inc/assert.h>
+#include <kern/cpu/kclock.h>
+#include <kern/proc/user_environment.h>
+#include "../mem/memory_manager.h"
+#include "../mem/chunk_operations.h"
+
+//Ranges used in the address space of the temp. process (away from its code & stack)
+#define CHUNK_SRC	0x10000000
+#define CHUNK_COPY	0x18000000
+#define CHUNK_SHARE	0x20000000
+#define CHUNK_CUT	0x28000000
+
+static uint32 free_frames_count()
+{
+	struct freeFramesCounters counters = calculate_available_frames();
+	return counters.freeBuffered + counters.freeNotBuffered;
+}
+
+static uint64 to_cycles(struct uint64 t)
+{
+	return ((uint64)t.hi << 32) | t.low;
+}
+
+static void print_cost(char *op, uint32 num_of_pages, uint64 cycles)
+{
+	cprintf("%25s: %5d pages => %10llu cycles (%llu cycles/page)\n",
+			op, num_of_pages, cycles, cycles / num_of_pages);
+}
+
+//Run each chunk operation once on a range of num_of_pages pages of a temp.
+//process & print its cost
+static void measure_chunk_ops(uint32 num_of_pages)
+{
+	struct Env *env = env_create("fos_helloWorld", 20, 0, 0);
+	if (env == NULL)
+		panic("Loading programs failed\n");
+	uint32 *pgdir = env->env_page_directory;
+	uint32 size = num_of_pages * PAGE_SIZE;
+	uint32 free_frames_before = free_frames_count();
+	lcr3(env->env_cr3);
+
+	uint64 start = to_cycles(get_virtual_time());
+	uint32 required = calculate_required_frames(pgdir, CHUNK_SRC, size);
+	print_cost("calculate_required_frames", num_of_pages, to_cycles(get_virtual_time()) - start);
+	if (required != num_of_pages + ROUNDUP(size, PTSIZE) / PTSIZE)
+		panic("calculate_required_frames: %d frames instead of %d\n", required, num_of_pages + ROUNDUP(size, PTSIZE) / PTSIZE);
+
+	start = to_cycles(get_virtual_time());
+	int ret = allocate_chunk(pgdir, CHUNK_SRC, size, PERM_USER | PERM_WRITEABLE);
+	print_cost("allocate_chunk", num_of_pages, to_cycles(get_virtual_time()) - start);
+	if (ret != 0)
+		panic("allocate_chunk failed\n");
+	for (uint32 i = 0; i < num_of_pages; i++)
+		*(uint32*)(CHUNK_SRC + i * PAGE_SIZE) = i;
+
+	uint32 num_tables, num_pages;
+	start = to_cycles(get_virtual_time());
+	calculate_allocated_space(pgdir, CHUNK_SRC, CHUNK_SRC + size, &num_tables, &num_pages);
+	print_cost("calculate_allocated_space", num_of_pages, to_cycles(get_virtual_time()) - start);
+	if (num_pages != num_of_pages)
+		panic("calculate_allocated_space: %d pages instead of %d\n", num_pages, num_of_pages);
+
+	start = to_cycles(get_virtual_time());
+	ret = copy_paste_chunk(pgdir, CHUNK_SRC, CHUNK_COPY, size);
+	print_cost("copy_paste_chunk", num_of_pages, to_cycles(get_virtual_time()) - start);
+	if (ret != 0)
+		panic("copy_paste_chunk failed\n");
+
+	start = to_cycles(get_virtual_time());
+	ret = share_chunk(pgdir, CHUNK_SRC, CHUNK_SHARE, size, PERM_USER);
+	print_cost("share_chunk", num_of_pages, to_cycles(get_virtual_time()) - start);
+	if (ret != 0)
+		panic("share_chunk failed\n");
+
+	start = to_cycles(get_virtual_time());
+	ret = cut_paste_pages(pgdir, CHUNK_SRC, CHUNK_CUT, num_of_pages);
+	print_cost("cut_paste_pages", num_of_pages, to_cycles(get_virtual_time()) - start);
+	if (ret != 0)
+		panic("cut_paste_pages failed\n");
+
+	//all the ranges now see the same content, a denied call changes nothing
+	for (uint32 i = 0; i < num_of_pages; i++)
+	{
+		uint32 off = i * PAGE_SIZE;
+		if (*(uint32*)(CHUNK_COPY + off) != i || *(uint32*)(CHUNK_SHARE + off) != i || *(uint32*)(CHUNK_CUT + off) != i)
+			panic("chunk operations: wrong content at page %d\n", i);
+	}
+	if (cut_paste_pages(pgdir, CHUNK_COPY, CHUNK_SHARE, num_of_pages) != -1 ||
+			*(uint32*)(CHUNK_COPY) != 0)
+		panic("cut_paste_pages: not denied on existing pages\n");
+
+	lcr3(phys_page_directory);
+	env_free(env);
+	uint32 free_frames_after = free_frames_count();
+	if (free_frames_after < free_frames_before)
+		panic("chunk operations leaked %d frames\n", free_frames_before - free_frames_after);
+}
+
+//The cost of each chunk operation should follow the # pages of its range:
+//a page table is looked up once for all of its entries
+void test_chunk_ops_cost()
+{
+	uint32 sizes[] = {1, 16, 256, 1024, 4096};
+	for (int i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+		measure_chunk_ops(sizes[i]);
+
+	cprintf("Congratulations... chunk operations cost benchmark completed\n");
+}
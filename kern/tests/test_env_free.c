@@ -0,0 +1,77 @@
+/*
+ * test_env_free.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <kern/tests/test_env_free.h>
+
+#include <inc/memlayout.h>
+#include <inc/assert.h>
+#include <kern/cpu/kclock.h>
+#include <kern/proc/user_environment.h>
+#include "../mem/memory_manager.h"
+
+static uint32 free_frames_count()
+{
+	struct freeFramesCounters counters = calculate_available_frames();
+	return counters.freeBuffered + counters.freeNotBuffered;
+}
+
+static uint64 to_cycles(struct uint64 t)
+{
+	return ((uint64)t.hi << 32) | t.low;
+}
+
+//Load a program, map 'num_of_pages' extra frames in its user heap, then
+//measure how long env_free() takes to tear the whole address space down.
+static void measure_kill_latency(uint32 num_of_pages)
+{
+	struct Env *env = env_create("fos_helloWorld", 20, 0, 0);
+	if (env == NULL)
+		panic("Loading programs failed\n");
+
+	uint32 free_frames_before = free_frames_count();
+	uint32 mapped = 0;
+	for (; mapped < num_of_pages; mapped++)
+	{
+		uint32 va = USER_HEAP_START + mapped * PAGE_SIZE;
+		if (va >= USER_HEAP_MAX)
+			break;
+		struct FrameInfo *ptr_frame_info = NULL;
+		if (allocate_frame(&ptr_frame_info) != 0)
+			break;
+		if (map_frame(env->env_page_directory, ptr_frame_info, va, PERM_USER | PERM_WRITEABLE) != 0)
+		{
+			free_frame(ptr_frame_info);
+			break;
+		}
+	}
+
+	uint64 start = to_cycles(get_virtual_time());
+	env_free(env);
+	uint64 end = to_cycles(get_virtual_time());
+
+	uint32 free_frames_after = free_frames_count();
+	if (free_frames_after < free_frames_before)
+		panic("env_free() leaked %d frames of the %d mapped heap pages\n", free_frames_before - free_frames_after, mapped);
+
+	cprintf("kill latency: %5d heap pages mapped => %10llu cycles (%llu cycles/page)\n",
+			mapped, end - start, (end - start) / (mapped + 1));
+}
+
+void test_env_free_latency(uint32 num_of_pages)
+{
+	if (num_of_pages != 0)
+	{
+		measure_kill_latency(num_of_pages);
+		return;
+	}
+
+	//The cost should follow the # of mapped pages, not the size of the user
+	//virtual space: a nearly empty process must die almost for free.
+	uint32 sizes[] = {0, 16, 256, 1024, 4096};
+	for (int i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+		measure_kill_latency(sizes[i]);
+
+	cprintf("Congratulations... env_free() kill latency benchmark completed\n");
+}
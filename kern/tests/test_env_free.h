@@ -0,0 +1,18 @@
+/*
+ * test_env_free.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef KERN_TESTS_TEST_ENV_FREE_H_
+#define KERN_TESTS_TEST_ENV_FREE_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/types.h>
+
+void test_env_free_latency(uint32 num_of_pages);
+
+#endif /* KERN_TESTS_TEST_ENV_FREE_H_ */
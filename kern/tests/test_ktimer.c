@@ -0,0 +1,72 @@
+/*
+ * test_ktimer.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <kern/tests/test_ktimer.h>
+
+#include <inc/assert.h>
+#include <kern/cpu/ktimer.h>
+
+static uint32 fired_at[16];
+
+static void test_ktimer_fired(struct ktimer *t)
+{
+	uint32 *at = (uint32 *)t->arg;
+	if (*at != 0)
+		panic("timer fired twice\n");
+	*at = ktimer_wheel.now;
+}
+
+//Each timer must fire exactly at its expiry tick, whatever the level it starts
+//at (incl. the ones beyond the wheel span), & a cancelled one must not fire.
+//Ticks are given to the wheel by hand: run it with no env running.
+void test_ktimer_wheel()
+{
+	static struct ktimer timers[16];
+	uint32 delays[] = { 1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 100000, KTIMER_MAX_DELAY + 5000 };
+	int num_of_timers = sizeof(delays) / sizeof(delays[0]);
+
+	uint32 start = ktimer_wheel.now;
+	uint32 pending = ktimer_wheel.pending;
+	for (int i = 0; i < num_of_timers; i++)
+	{
+		fired_at[i] = 0;
+		timers[i].list = NULL;
+		ktimer_add(&timers[i], delays[i], test_ktimer_fired, &fired_at[i]);
+	}
+	//cancel one, re-arm another
+	if (!ktimer_cancel(&timers[5]))
+		panic("cancelling a pending timer failed\n");
+	ktimer_add(&timers[6], 200, test_ktimer_fired, &fired_at[6]);
+	delays[6] = 200;
+
+	if (ktimer_ticks_to_next() != 1)
+		panic("wrong ticks to the next timer. Expected = %d, Actual = %d\n", 1, ktimer_ticks_to_next());
+
+	//advance in steps of different lengths (as stretched clock intervals do)
+	uint32 max_delay = delays[num_of_timers - 1];
+	uint32 step = 1;
+	while (ktimer_wheel.now - start < max_delay)
+	{
+		uint32 remaining = max_delay - (ktimer_wheel.now - start);
+		ktimer_tick(step < remaining ? step : remaining);
+		step = step % 7 + 1;
+	}
+
+	for (int i = 0; i < num_of_timers; i++)
+	{
+		if (i == 5)
+		{
+			if (fired_at[i] != 0)
+				panic("a cancelled timer fired\n");
+			continue;
+		}
+		if (fired_at[i] != start + delays[i])
+			panic("timer #%d fired at a wrong tick. Expected = %d, Actual = %d\n", i, start + delays[i], fired_at[i]);
+	}
+	if (ktimer_wheel.pending != pending)
+		panic("wrong # pending timers. Expected = %d, Actual = %d\n", pending, ktimer_wheel.pending);
+
+	cprintf("Congratulations!! test kernel timer wheel completed successfully.\n");
+}
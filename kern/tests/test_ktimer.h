@@ -0,0 +1,16 @@
+/*
+ * test_ktimer.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef KERN_TESTS_TEST_KTIMER_H_
+#define KERN_TESTS_TEST_KTIMER_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+void test_ktimer_wheel();
+
+#endif /* KERN_TESTS_TEST_KTIMER_H_ */
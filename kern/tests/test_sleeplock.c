@@ -0,0 +1,90 @@
+/*
+ * test_sleeplock.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <kern/tests/test_sleeplock.h>
+
+#include <inc/assert.h>
+#include <kern/proc/user_environment.h>
+#include <kern/cpu/sched.h>
+#include <kern/conc/sleeplock.h>
+#include <kern/conc/lockstat.h>
+#include "../cmd/command_prompt.h"
+
+#define SLPLK_BENCH_SLAVES	5
+
+//Contended sleep lock benchmark: slaves hammer the test sleep lock (see
+//sys_utilities), first with wakeup_all on release then with the direct
+//hand-off. Each run ends at the prompt, so it's done in 3 calls:
+//	#1: run with wakeup_all, #2: run with hand-off, #3: compare the blocks
+//(i.e. context switches) per acquisition
+static int slplk_bench_step = 0;
+static uint32 slplk_bench_acquires[2], slplk_bench_blocks[2];
+static uint8 slplk_bench_old_handoff;
+
+static void slplk_bench_snapshot(struct lock_class *cls, int run, int sign)
+{
+	slplk_bench_acquires[run] += sign * cls->acquires;
+	slplk_bench_blocks[run] += sign * cls->blocks;
+}
+
+static void slplk_bench_run(uint8 handoff)
+{
+	enableSleeplockHandoff(handoff);
+	for (int i = 0; i < SLPLK_BENCH_SLAVES; i++)
+	{
+		struct Env *env = env_create("slplkSlave", 50, 0, 0);
+		if (env == NULL)
+			panic("Loading programs failed\n");
+		sched_new_env(env);
+	}
+	cprintf("> Running with %s... (After all running programs finish, Run the same command again.)\n",
+			handoff ? "direct hand-off" : "wakeup all");
+	execute_command("runall");
+}
+
+void test_sleeplock_handoff()
+{
+	//the class of the test sleep lock (the same one whether it's initialized yet or not)
+	struct lock_class *cls = lockstat_class(LOCKSTAT_SLEEP, "Test Sleep Lock");
+	switch (slplk_bench_step)
+	{
+	case 0:
+		slplk_bench_old_handoff = isSleeplockHandoffEnabled();
+		slplk_bench_acquires[0] = slplk_bench_acquires[1] = 0;
+		slplk_bench_blocks[0] = slplk_bench_blocks[1] = 0;
+		slplk_bench_snapshot(cls, 0, -1);
+		slplk_bench_step = 1;
+		slplk_bench_run(0);
+		break;
+	case 1:
+		slplk_bench_snapshot(cls, 0, 1);
+		slplk_bench_snapshot(cls, 1, -1);
+		slplk_bench_step = 2;
+		slplk_bench_run(1);
+		break;
+	default:
+		slplk_bench_snapshot(cls, 1, 1);
+		slplk_bench_step = 0;
+		enableSleeplockHandoff(slplk_bench_old_handoff);
+
+		for (int run = 0; run < 2; run++)
+		{
+			if (slplk_bench_acquires[run] == 0)
+				panic("no acquisition of the test sleep lock is counted\n");
+			cprintf("%-16s: %u acquisitions, %u blocks, %u.%02u blocks/acquisition\n",
+					run ? "direct hand-off" : "wakeup all",
+					slplk_bench_acquires[run], slplk_bench_blocks[run],
+					slplk_bench_blocks[run] / slplk_bench_acquires[run],
+					(slplk_bench_blocks[run] * 100 / slplk_bench_acquires[run]) % 100);
+		}
+		//with the hand-off, a process blocks at most once per acquisition
+		if (slplk_bench_blocks[1] > slplk_bench_acquires[1])
+			panic("direct hand-off: more blocks than acquisitions\n");
+		if (slplk_bench_blocks[1] > slplk_bench_blocks[0])
+			panic("direct hand-off: more blocks than with wakeup all\n");
+		cprintf("\nCongratulations!! test sleep lock hand-off completed successfully.\n");
+		break;
+	}
+}
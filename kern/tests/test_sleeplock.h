@@ -0,0 +1,16 @@
+/*
+ * test_sleeplock.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef KERN_TESTS_TEST_SLEEPLOCK_H_
+#define KERN_TESTS_TEST_SLEEPLOCK_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+void test_sleeplock_handoff();
+
+#endif /* KERN_TESTS_TEST_SLEEPLOCK_H_ */
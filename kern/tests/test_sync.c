@@ -0,0 +1,78 @@
+/*
+ * test_sync.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <kern/tests/test_sync.h>
+
+#include <inc/assert.h>
+#include <kern/conc/spinlock.h>
+#include <kern/conc/ksemaphore.h>
+#include <kern/conc/rwsleeplock.h>
+#include <kern/conc/completion.h>
+#include <kern/conc/lockstat.h>
+
+//The non-blocking paths of the kernel sync primitives & their statistics
+//(the test runs in the kernel prompt: no process to block)
+void test_sync_primitives()
+{
+	//[1] spinlock: each acquire is counted in its class
+	static struct spinlock lk1, lk2;
+	init_spinlock(&lk1, "test sync spinlock");
+	init_spinlock(&lk2, "test sync spinlock");
+	if (lk1.stats == NULL || lk1.stats != lk2.stats)
+		panic("locks of the same name should share the same statistics\n");
+	uint32 acquires = lk1.stats->acquires;
+	for (int i = 0; i < 10; i++)
+	{
+		acquire_spinlock(&lk1);
+		release_spinlock(&lk1);
+		acquire_spinlock(&lk2);
+		release_spinlock(&lk2);
+	}
+	if (lk1.stats->acquires - acquires != 20)
+		panic("wrong # acquires. Expected = %d, Actual = %d\n", 20, lk1.stats->acquires - acquires);
+
+	//[2] ksemaphore: waits within the count don't block nor contend
+	static struct ksemaphore ksem;
+	init_ksemaphore(&ksem, 3, "test sync semaphore");
+	uint32 contended = ksem.stats->contended;
+	for (int i = 0; i < 3; i++)
+		wait_ksemaphore(&ksem);
+	if (ksem.count != 0 || ksem.stats->contended != contended)
+		panic("wrong semaphore count/contention. Expected = %d/%d, Actual = %d/%d\n", 0, contended, ksem.count, ksem.stats->contended);
+	for (int i = 0; i < 3; i++)
+		signal_ksemaphore(&ksem);
+	if (ksem.count != 3)
+		panic("wrong semaphore count. Expected = %d, Actual = %d\n", 3, ksem.count);
+
+	//[3] rwsleeplock: many readers at once
+	static struct rwsleeplock rwlk;
+	init_rwsleeplock(&rwlk, "test sync rwlock");
+	acquire_read_rwsleeplock(&rwlk);
+	acquire_read_rwsleeplock(&rwlk);
+	if (rwlk.readers != 2 || rwlk.writing)
+		panic("wrong # readers. Expected = %d, Actual = %d\n", 2, rwlk.readers);
+	release_read_rwsleeplock(&rwlk);
+	release_read_rwsleeplock(&rwlk);
+	if (rwlk.readers != 0)
+		panic("wrong # readers. Expected = %d, Actual = %d\n", 0, rwlk.readers);
+
+	//[4] completion: a wait after complete() passes, complete_all() lets all pass
+	static struct completion cmp;
+	init_completion(&cmp, "test sync completion");
+	complete(&cmp);
+	complete(&cmp);
+	wait_for_completion(&cmp);
+	wait_for_completion(&cmp);
+	if (cmp.done != 0)
+		panic("wrong # completions left. Expected = %d, Actual = %d\n", 0, cmp.done);
+	complete_all(&cmp);
+	for (int i = 0; i < 5; i++)
+		wait_for_completion(&cmp);
+	reinit_completion(&cmp);
+	if (cmp.done != 0)
+		panic("completion is not reinitialized\n");
+
+	cprintf("Congratulations!! test sync primitives completed successfully.\n");
+}
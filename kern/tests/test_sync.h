@@ -0,0 +1,16 @@
+/*
+ * test_sync.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef KERN_TESTS_TEST_SYNC_H_
+#define KERN_TESTS_TEST_SYNC_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+void test_sync_primitives();
+
+#endif /* KERN_TESTS_TEST_SYNC_H_ */
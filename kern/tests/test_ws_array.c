@@ -0,0 +1,75 @@
+/*
+ * test_ws_array.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <kern/tests/test_ws_array.h>
+
+#include <inc/memlayout.h>
+#include <inc/assert.h>
+#include <inc/x86.h>
+#include <kern/proc/user_environment.h>
+#include <kern/trap/fault_handler.h>
+#include "../mem/memory_manager.h"
+
+//Load a program with the given WS size (as a list or as an array), then fault
+//on 4 x ws_size heap pages in a loop so that nearly every fault is a
+//replacement. Returns the average cycles spent per fault.
+static uint64 measure_fault_cycles(uint32 ws_size, uint8 use_array)
+{
+	uint32 old_ws_array = isWSArrayEnabled();
+	enableWSArray(use_array);
+	struct Env *env = env_create("fos_helloWorld", ws_size, 0, 0);
+	enableWSArray(old_ws_array);
+	if (env == NULL)
+		panic("Loading programs failed\n");
+	if ((env->page_WS_array != NULL) != use_array)
+		panic("WS of the env is not kept in the requested representation\n");
+
+	//the faulted pages are read/written through the env's address space
+	uint32 old_cr3 = rcr3();
+	lcr3(env->env_cr3);
+
+	memset(&ws_fault_cycles[use_array], 0, sizeof(ws_fault_cycles[use_array]));
+	uint32 num_of_pages = 4 * ws_size;
+	for (int round = 0; round < 4; round++)
+	{
+		for (uint32 p = 0; p < num_of_pages; p++)
+		{
+			uint32 va = USER_HEAP_START + p * PAGE_SIZE;
+			if (!(pt_get_page_permissions(env->env_page_directory, va) & PERM_PRESENT))
+				page_fault_handler(env, va);
+		}
+	}
+
+	uint32 ws_content = use_array ? env->page_WS_array_size : LIST_SIZE(&(env->page_WS_list));
+	if (ws_content != env->page_WS_max_size)
+		panic("WS is expected to be full (%d pages) but it contains %d pages\n", env->page_WS_max_size, ws_content);
+
+	lcr3(old_cr3);
+	env_free(env);
+
+	uint32 faults = ws_fault_cycles[use_array].faults;
+	return faults ? ws_fault_cycles[use_array].cycles / faults : 0;
+}
+
+void test_ws_fault_cycles(uint32 ws_size)
+{
+	uint32 sizes[] = {20, 100, 500};
+	uint32 num_of_sizes = sizeof(sizes)/sizeof(sizes[0]);
+	if (ws_size != 0)
+	{
+		sizes[0] = ws_size;
+		num_of_sizes = 1;
+	}
+
+	for (int i = 0; i < num_of_sizes; i++)
+	{
+		uint64 list_cycles = measure_fault_cycles(sizes[i], 0);
+		uint64 array_cycles = measure_fault_cycles(sizes[i], 1);
+		cprintf("WS size %4d: list => %8llu cycles/fault, array => %8llu cycles/fault\n",
+				sizes[i], list_cycles, array_cycles);
+	}
+
+	cprintf("Congratulations... WS list vs. array fault benchmark completed\n");
+}
@@ -0,0 +1,18 @@
+/*
+ * test_ws_array.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef KERN_TESTS_TEST_WS_ARRAY_H_
+#define KERN_TESTS_TEST_WS_ARRAY_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/types.h>
+
+void test_ws_fault_cycles(uint32 ws_size);
+
+#endif /* KERN_TESTS_TEST_WS_ARRAY_H_ */
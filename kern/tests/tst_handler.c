@@ -19,6 +19,12 @@
 #include "../tests/test_commands.h"
 #include "../tests/test_dynamic_allocator.h"
 #include "../tests/test_scheduler.h"
+#include "../tests/test_env_free.h"
+#include "../tests/test_ws_array.h"
+#include "../tests/test_sync.h"
+#include "../tests/test_sleeplock.h"
+#include "../tests/test_ktimer.h"
+#include "../tests/test_chunk_ops.h"
 
 struct Test tests[] = {
 		{"3functions", "Env Load: test the creation of new dir, tables and pages WS", tst_three_creation_functions},
@@ -38,6 +44,11 @@ struct Test tests[] = {
 		{"pg", "Test paging manipulation for a specific page", tst_paging_manipulation},
 		{"chunks","Test chunk manipulations", tst_chunks },
 		{"kheap", "Test KHEAP functions", tst_kheap},
+		{"killlat", "Benchmark env_free() latency vs. # of mapped pages", tst_kill_latency},
+		{"wsfault", "Benchmark cycles per page fault with the WS as a list vs. an array", tst_ws_fault_cycles},
+		{"sync", "Test kernel semaphores, rw sleep locks, completions & lock statistics", tst_sync},
+		{"slplk", "Benchmark context switches per contended sleep lock acquisition: wakeup all vs. direct hand-off", tst_sleeplock_handoff},
+		{"ktimer", "Test the kernel timer wheel (expiry at every level, cancel, re-arm)", tst_ktimer},
 
 };
 
@@ -290,6 +301,11 @@ int tst_chunks(int number_of_arguments, char **arguments)
 	{
 		test_calculate_allocated_space();
 	}
+	//2026: COST Benchmark
+	else if(strcmp(arguments[1], "cost") == 0)
+	{
+		test_chunk_ops_cost();
+	}
 	return 0;
 }
 
@@ -490,6 +506,51 @@ int tst_kheap(int number_of_arguments, char **arguments)
 	return 0;
 }
 
+int tst_kill_latency(int number_of_arguments, char **arguments)
+{
+	if (number_of_arguments > 2)
+	{
+		cprintf("Invalid number of arguments! USAGE: tst killlat [<num_of_pages>]\n");
+		return 0;
+	}
+	uint32 num_of_pages = 0;
+	if (number_of_arguments == 2)
+		num_of_pages = strtol(arguments[1], NULL, 10);
+	test_env_free_latency(num_of_pages);
+	return 0;
+}
+
+int tst_ws_fault_cycles(int number_of_arguments, char **arguments)
+{
+	if (number_of_arguments > 2)
+	{
+		cprintf("Invalid number of arguments! USAGE: tst wsfault [<ws_size>]\n");
+		return 0;
+	}
+	uint32 ws_size = 0;
+	if (number_of_arguments == 2)
+		ws_size = strtol(arguments[1], NULL, 10);
+	test_ws_fault_cycles(ws_size);
+	return 0;
+}
+
+int tst_sync(int number_of_arguments, char **arguments)
+{
+	test_sync_primitives();
+	return 0;
+}
+
+int tst_sleeplock_handoff(int number_of_arguments, char **arguments)
+{
+	test_sleeplock_handoff();
+	return 0;
+}
+
+int tst_ktimer(int number_of_arguments, char **arguments)
+{
+	test_ktimer_wheel();
+	return 0;
+}
 
 //END======================================================
 
@@ -50,6 +50,11 @@ int tst_dyn_alloc(int number_of_arguments, char **arguments);
 int tst_paging_manipulation(int number_of_arguments, char **arguments);
 int tst_chunks(int number_of_arguments, char **arguments);
 int tst_kheap(int number_of_arguments, char **arguments);
+int tst_kill_latency(int number_of_arguments, char **arguments);
+int tst_ws_fault_cycles(int number_of_arguments, char **arguments);
+int tst_sync(int number_of_arguments, char **arguments);
+int tst_sleeplock_handoff(int number_of_arguments, char **arguments);
+int tst_ktimer(int number_of_arguments, char **arguments);
 
 
 
@@ -259,7 +259,10 @@ void sys_utilities(char* utilityName, int value)
 	else if (strcmp(utilityName, "__GetReadyQueueSize__") == 0)
 	{
 		int* numOfProcesses = (int*) value ;
+		acquire_spinlock(&ProcessQueues.qlock);
+		sched_drain_wakeups();	//the woken up envs are ready too
 		*numOfProcesses = LIST_SIZE(&ProcessQueues.env_ready_queues[0]);
+		release_spinlock(&ProcessQueues.qlock);
 	}
 	else if (strcmp(utilityName, "__AcquireSleepLock__") == 0)
 	{
@@ -53,6 +53,13 @@ uint8 isBufferingEnabled(){  return _EnableBuffering ; }
 void setModifiedBufferLength(uint32 length) { _ModifiedBufferLength = length;}
 uint32 getModifiedBufferLength() { return _ModifiedBufferLength;}
 
+//===============================
+// WS REPRESENTATION
+//===============================
+//Envs created while it's enabled keep their WS in a compact array instead of the list
+/*2026*/ void enableWSArray(uint32 enableIt){_EnableWSArray = enableIt;}
+/*2026*/ uint8 isWSArrayEnabled(){  return _EnableWSArray ; }
+
 //===============================
 // FAULT HANDLERS
 //===============================
@@ -147,6 +154,14 @@ void fault_handler(struct Trapframe *tf)
 	}
 	else
 	{
+		/*Write on a copy-on-write page shared by fork: take a private copy & retry*/
+		if ((tf->tf_err & FEC_WR) &&
+			(pt_get_page_permissions(faulted_env->env_page_directory, fault_va) & (PERM_PRESENT | PERM_COW)) == (PERM_PRESENT | PERM_COW))
+		{
+			cow_fault_handler(faulted_env, fault_va);
+			return;
+		}
+
 		if (userTrap)
 		{
 			/*============================================================================================*/
@@ -232,15 +247,65 @@ void table_fault_handler(struct Env * curenv, uint32 fault_va)
 #endif
 }
 
+//=============================
+// [2.1] COPY-ON-WRITE HANDLER:
+//=============================
+// Resolve a write on a PERM_COW page (see env_fork()). If the env is the last
+// one referencing the frame, just give it the write access back; otherwise
+// copy the page into a new frame that becomes private to this env.
+void cow_fault_handler(struct Env * curenv, uint32 fault_va)
+{
+	uint32 va = ROUNDDOWN(fault_va, PAGE_SIZE);
+	uint32 *ptr_page_table = NULL;
+	struct FrameInfo *old_frame = get_frame_info(curenv->env_page_directory, va, &ptr_page_table);
+	uint32 entry = ptr_page_table[PTX(va)];
+	uint32 perms = (entry & 0xFFF & ~PERM_COW) | PERM_WRITEABLE;
+
+	if (old_frame->references == 1)
+	{
+		ptr_page_table[PTX(va)] = CONSTRUCT_ENTRY(EXTRACT_ADDRESS(entry), perms);
+		tlb_invalidate(curenv->env_page_directory, (void*)va);
+		return;
+	}
+
+	struct FrameInfo *new_frame = NULL;
+	if (allocate_frame(&new_frame) != 0)
+		env_exit();
+
+	//Fill it through the temp page of this env (the faulted page itself is read-only)
+	map_frame(curenv->env_page_directory, new_frame, (uint32)PGFLTEMP, PERM_WRITEABLE);
+	memcpy((void*)PGFLTEMP, (void*)va, PAGE_SIZE);
+	new_frame->references++;
+	unmap_frame(curenv->env_page_directory, (uint32)PGFLTEMP);
+	new_frame->references--;
+
+	//Swap the frames: the live PTE count of the table is unchanged
+	ptr_page_table[PTX(va)] = CONSTRUCT_ENTRY(to_physical_address(new_frame), perms);
+	new_frame->references++;
+	//its WS element (if this env owns the one of the old frame) moves with it
+	if (old_frame->wse_dir == curenv->env_page_directory)
+	{
+		new_frame->wse = old_frame->wse;
+		new_frame->wse_dir = old_frame->wse_dir;
+		new_frame->ws_index = old_frame->ws_index;
+		old_frame->wse = NULL;
+		old_frame->wse_dir = NULL;
+	}
+	decrement_references(old_frame);
+	tlb_invalidate(curenv->env_page_directory, (void*)va);
+}
+
 //=========================
 // [3] PAGE FAULT HANDLER:
 //=========================
-void
-page_ws_list_insert_element(struct Env * faulted_env, uint32 fault_va) {
+//Allocate & map a frame for the faulted page and read it from the page file.
+//Returns NULL if the page doesn't exist anywhere (the env is exited)
+static struct FrameInfo*
+page_ws_place_faulted_page(struct Env * faulted_env, uint32 fault_va) {
 	struct FrameInfo *new_frame = NULL;
 	allocate_frame(&new_frame);
 	if (new_frame == NULL) {
-		panic("fault_handler.c::page_ws_list_insert_element(), Failed to allocate frame");
+		panic("fault_handler.c::page_ws_place_faulted_page(), Failed to allocate frame");
 	}
 	map_frame(faulted_env->env_page_directory, new_frame, fault_va, PERM_USER | PERM_WRITEABLE | PERM_PRESENT);
 	
@@ -248,24 +313,21 @@ page_ws_list_insert_element(struct Env * faulted_env, uint32 fault_va) {
 		if (!((fault_va >= USER_HEAP_START && fault_va < USER_HEAP_MAX) || (fault_va >= USTACKBOTTOM && fault_va < USTACKTOP))) {
 			unmap_frame(faulted_env->env_page_directory, fault_va);
 			env_exit();
-			return;
+			return NULL;
 		}
 	}
+	return new_frame;
+}
 
-	struct WorkingSetElement *new_element = env_page_ws_list_create_element(faulted_env, fault_va);
-	if (new_element == NULL) {
-        panic("fault_handler.c::page_ws_list_insert_element: Failed to create WS element!");
-    }
-	// Added to implement O(1) free_user_mem
-	new_frame->wse = new_element;
-
-    if (faulted_env->page_last_WS_element == NULL) {
-	    LIST_INSERT_TAIL(&(faulted_env->page_WS_list), new_element);
-		if(LIST_SIZE(&(faulted_env->page_WS_list)) == faulted_env->page_WS_max_size) {
-			faulted_env->page_last_WS_element = LIST_FIRST(&(faulted_env->page_WS_list));
-		}
-	} else {
-		LIST_INSERT_BEFORE(&(faulted_env->page_WS_list), faulted_env->page_last_WS_element, new_element);
+void
+page_ws_list_insert_element(struct Env * faulted_env, uint32 fault_va) {
+	struct FrameInfo *new_frame = page_ws_place_faulted_page(faulted_env, fault_va);
+	if (new_frame == NULL) {
+		return;
+	}
+
+	if (!env_page_ws_add(faulted_env, fault_va, new_frame)) {
+		panic("fault_handler.c::page_ws_list_insert_element: the WS is full!");
 	}
 }
 
@@ -337,8 +399,107 @@ update_WS(struct Env * faulted_env , int max_N) {
 	
 }
 
+#if USE_KHEAP
+//Same nth chance clock as above, on the compact WS array: the scan is a
+//linear sweep over contiguous entries starting at the clock hand.
+static void
+page_ws_array_fault(struct Env * faulted_env, uint32 fault_va)
+{
+	struct WSArrayEntry *ws = faulted_env->page_WS_array;
+	uint32 max_size = faulted_env->page_WS_max_size;
+	uint32 *pgdir = faulted_env->env_page_directory;
+
+	if (faulted_env->page_WS_array_size < max_size)
+	{
+		struct FrameInfo *new_frame = page_ws_place_faulted_page(faulted_env, fault_va);
+		if (new_frame != NULL)
+			env_page_ws_array_insert(faulted_env, fault_va, new_frame);
+		return;
+	}
+
+	int N = page_WS_max_sweeps;
+	int is_MODIFIED_version = 0;
+	if (N < 0) {
+		N *= -1;
+		is_MODIFIED_version = 1;
+	}
+	uint32 hand = faulted_env->page_last_WS_index;
+
+	//[1] select the victim
+	int max_sweeps_counter = -2;
+	uint32 victim = hand;
+	for (uint32 k = 0, i = hand; k < max_size; k++, i = (i + 1 == max_size) ? 0 : i + 1)
+	{
+		uint32 perm = pt_get_page_permissions(pgdir, WSA_VA(&ws[i]));
+		int curN = (perm & PERM_USED) ? 0 : WSA_SWEEPS(&ws[i]);
+		if (is_MODIFIED_version && (perm & PERM_MODIFIED)) {
+			curN -= 1;
+		}
+		if (curN > max_sweeps_counter) {
+			max_sweeps_counter = curN;
+			victim = i;
+		}
+	}
+
+	//[2] advance the sweeps counters (as update_WS())
+	int Number_of_iterations = N - max_sweeps_counter;
+	for (uint32 k = 0, i = hand; k < max_size; k++, i = (i + 1 == max_size) ? 0 : i + 1)
+	{
+		uint32 va = WSA_VA(&ws[i]);
+		uint32 perm = pt_get_page_permissions(pgdir, va);
+		int sweeps = WSA_SWEEPS(&ws[i]) + Number_of_iterations;
+		if (perm & PERM_USED) {
+			pt_set_page_permissions(pgdir, va, 0, PERM_USED);
+			sweeps = Number_of_iterations;
+		}
+		WSA_SET(&ws[i], va, sweeps);
+
+		int curN = sweeps;
+		if (is_MODIFIED_version && (perm & PERM_MODIFIED)) {
+			curN -= 1;
+		}
+		if (curN == N) {
+			Number_of_iterations--;
+			if (Number_of_iterations <= 0) {
+				break;
+			}
+		}
+	}
+
+	//[3] write back & drop the victim, then place the faulted page in its slot
+	uint32 victim_va = WSA_VA(&ws[victim]);
+	if (pt_get_page_permissions(pgdir, victim_va) & PERM_MODIFIED)
+	{
+		uint32 *page_table = NULL;
+		struct FrameInfo *frame_info = get_frame_info(pgdir, victim_va, &page_table);
+		if (pf_update_env_page(faulted_env, victim_va, frame_info) == E_NO_PAGE_FILE_SPACE) {
+			panic("fault_handler.c::page_ws_array_fault: Failed to creat new environment page (No space)!");
+		}
+	}
+	unmap_frame(pgdir, victim_va);
+	env_page_ws_array_clear(faulted_env, victim);
+
+	faulted_env->page_last_WS_index = victim;
+	struct FrameInfo *new_frame = page_ws_place_faulted_page(faulted_env, fault_va);
+	if (new_frame != NULL)
+		env_page_ws_array_insert(faulted_env, fault_va, new_frame);
+	faulted_env->page_last_WS_index = (victim + 1) % max_size;
+}
+#endif
+
 void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 {
+#if USE_KHEAP
+	uint64 start_cycles = read_tsc();
+	uint8 rep = (faulted_env->page_WS_array != NULL);
+	if (rep)
+	{
+		page_ws_array_fault(faulted_env, ROUNDDOWN(fault_va, PAGE_SIZE));
+		ws_fault_cycles[rep].faults++;
+		ws_fault_cycles[rep].cycles += read_tsc() - start_cycles;
+		return;
+	}
+#endif
 #if USE_KHEAP
 		struct WorkingSetElement *victimWSElement = NULL;
 		uint32 wsSize = LIST_SIZE(&(faulted_env->page_WS_list)); // size of the page working LIST
@@ -397,7 +558,10 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 		page_ws_list_insert_element(faulted_env, fault_va);
 
 	}
-	
+#if USE_KHEAP
+	ws_fault_cycles[rep].faults++;
+	ws_fault_cycles[rep].cycles += read_tsc() - start_cycles;
+#endif
 }
 
 void __page_fault_handler_with_buffering(struct Env * curenv, uint32 fault_va)
@@ -18,6 +18,7 @@
 /******************************/
 uint32 _EnableModifiedBuffer ;
 uint32 _EnableBuffering ;
+/*2026*/ uint32 _EnableWSArray ;
 
 uint32 _PageRepAlgoType;
 #define PG_REP_LRU_TIME_APPROX 0x1
@@ -62,6 +63,12 @@ uint8 isBufferingEnabled() ;
 void setModifiedBufferLength(uint32 length) ;
 uint32 getModifiedBufferLength();
 
+//===============================
+// WS REPRESENTATION
+//===============================
+/*2026*/ void enableWSArray(uint32 enableIt);
+/*2026*/ uint8 isWSArrayEnabled();
+
 //===============================
 // FAULT HANDLERS
 //===============================
@@ -70,5 +77,12 @@ void __page_fault_handler_with_buffering(struct Env * curenv, uint32 fault_va);
 void dyn_alloc_local_scope_method(struct Env * curenv, uint32 fault_va);
 void page_fault_handler(struct Env * curenv, uint32 fault_va);
 void table_fault_handler(struct Env * curenv, uint32 fault_va);
+void cow_fault_handler(struct Env * curenv, uint32 fault_va);
+
+/*2026*/ struct wsFaultCycles
+{
+	uint32 faults;
+	uint64 cycles;
+} ws_fault_cycles[2];	// cycles spent in page_fault_handler(): [0] WS list, [1] WS array
 
 #endif /* KERN_FAULT_HANDLER_H_ */
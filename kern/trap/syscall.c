@@ -11,6 +11,9 @@
 #include "syscall.h"
 #include <kern/cons/console.h>
 #include <kern/conc/channel.h>
+#include <kern/conc/futex.h>
+#include <kern/conc/ipc.h>
+#include <kern/cpu/ktimer.h>
 #include <kern/cpu/sched.h>
 #include <kern/cpu/cpu.h>
 #include <kern/disk/pagefile_manager.h>
@@ -349,10 +352,17 @@ void sys_allocate_chunk(uint32 virtual_address, uint32 size, uint32 perms)
 }
 
 //2014
-void sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size)
+int sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size)
 {
-	move_user_mem(cur_env, src_virtual_address, dst_virtual_address, size);
-	return;
+	//2026: both ranges must be inside the user heap
+	if (src_virtual_address < USER_HEAP_START || dst_virtual_address < USER_HEAP_START ||
+			size > USER_HEAP_MAX - USER_HEAP_START ||
+			src_virtual_address > USER_HEAP_MAX - size || dst_virtual_address > USER_HEAP_MAX - size)
+	{
+		env_exit();
+		return E_INVAL;
+	}
+	return move_user_mem(cur_env, src_virtual_address, dst_virtual_address, size);
 }
 
 //2015
@@ -483,6 +493,21 @@ int sys_create_env(char* programName, unsigned int page_WS_size,unsigned int LRU
 	return env->env_id;
 }
 
+//Fork the current env (copy-on-write). The child is placed in the NEW queue
+//like sys_create_env(): the parent should sys_run_env() it.
+//Returns the child id to the parent, while the child sees 0.
+int sys_env_fork(void)
+{
+	struct Env* env = env_fork(cur_env);
+	if(env == NULL)
+	{
+		return E_ENV_CREATION_ERROR;
+	}
+	sched_new_env(env);
+
+	return env->env_id;
+}
+
 //Place a new env into the READY queue
 void sys_run_env(int32 envId)
 {
@@ -515,7 +540,9 @@ void block_and_schedule_next(struct __semdata *semdata)
 	acquire_spinlock(&ProcessQueues.qlock);
 
 	cur_env->env_status = ENV_BLOCKED;
+	cur_env->blocked_chan = NULL;
 	enqueue(&semdata->queue , cur_env);
+	ProcessQueues.num_blocked++;
 
 	// avoid deadlock by releasing the semaphore lock before being blocked
 	semdata->lock = 0;
@@ -524,13 +551,11 @@ void block_and_schedule_next(struct __semdata *semdata)
 	release_spinlock(&ProcessQueues.qlock);
 }
 
+//2026: the semaphore queue is protected by its (user) lock: no need for the qlock
 void unblock_and_enqueue_ready(struct __semdata *semdata){
-	acquire_spinlock(&ProcessQueues.qlock);
-
 	struct Env *new_ready_proc = dequeue(&semdata->queue);
-	sched_insert_ready(new_ready_proc);
-
-	release_spinlock(&ProcessQueues.qlock);	
+	if (new_ready_proc != NULL)
+		sched_wakeup_lockfree(new_ready_proc);
 }
 
 void sys_env_set_priority(int32 envID, int priority)
@@ -538,6 +563,12 @@ void sys_env_set_priority(int32 envID, int priority)
 	env_set_priority(envID, priority);
 }
 
+//2026: CPU share of the given env under the STRIDE scheduler
+int sys_env_set_tickets(int32 envID, uint32 tickets)
+{
+	return env_set_tickets(envID, tickets);
+}
+
 /**************************************************************************/
 /************************* SYSTEM CALLS HANDLER ***************************/
 /**************************************************************************/
@@ -646,6 +677,9 @@ uint32 syscall(uint32 syscallno, uint32 a1, uint32 a2, uint32 a3, uint32 a4, uin
 		sys_run_env((int32)a1);
 		return 0;
 		break;
+	case SYS_env_fork:
+		return sys_env_fork();
+		break;
 	case SYS_getenvindex:
 		return sys_getenvindex();
 		break;
@@ -673,8 +707,7 @@ uint32 syscall(uint32 syscallno, uint32 a1, uint32 a2, uint32 a3, uint32 a4, uin
 		break;
 	}
 	case SYS_move_user_mem:
-		sys_move_user_mem(a1, a2, a3);
-		return 0;
+		return sys_move_user_mem(a1, a2, a3);
 		break;
 	case SYS_rcr2:
 		return sys_rcr2();
@@ -741,6 +774,26 @@ uint32 syscall(uint32 syscallno, uint32 a1, uint32 a2, uint32 a3, uint32 a4, uin
 		sys_env_set_priority(a1, a2);
 		break;
 
+	case SYS_env_set_tickets:
+		return sys_env_set_tickets(a1, a2);
+		break;
+
+	case SYS_futex_wait:
+		return futex_wait((uint32*)a1, a2);
+
+	case SYS_futex_wake:
+		return futex_wake((uint32*)a1, (int)a2);
+
+	case SYS_sleep_ms:
+		ktimer_sleep_ms(a1);
+		return 0;
+
+	case SYS_ipc_send:
+		return ipc_send((int32)a1, a2, a3, a4);
+
+	case SYS_ipc_recv:
+		return ipc_recv(a1, a2);
+
 	case NSYSCALLS:
 		return 	-E_INVAL;
 		break;
@@ -1,8 +1,16 @@
 #include <inc/lib.h>
 #include <inc/timerreg.h>
 
+//2026: blocks on a kernel timer: the sleeping env doesn't use the CPU
 void
 env_sleep(uint32 approxMilliSeconds)
+{
+	sys_sleep_ms(approxMilliSeconds);
+}
+
+//The old busy-waiting version (keeps the CPU busy for the whole period)
+void
+env_sleep_busy(uint32 approxMilliSeconds)
 {
 //	cprintf("%s go to sleep...\n", myEnv->prog_name);
 	uint32 time_in_cycles=approxMilliSeconds*CYCLES_PER_MILLISEC;
@@ -0,0 +1,84 @@
+// 2026: user-level mutexes & condition variables on top of the kernel futexes
+// Ref: U. Drepper, "Futexes Are Tricky" (mutex #2)
+
+#include "inc/lib.h"
+
+//===============================
+// MUTEX:
+//===============================
+void umutex_init(struct umutex *m)
+{
+	m->state = 0;
+}
+
+int umutex_trylock(struct umutex *m)
+{
+	return cmpxchg(&m->state, 0, 1) == 0;
+}
+
+void umutex_lock(struct umutex *m)
+{
+	//fast path: uncontended
+	if (cmpxchg(&m->state, 0, 1) == 0)
+		return;
+
+	//spin for a while: the owner may release it soon
+	for (int i = 0; i < FUTEX_SPIN_COUNT; i++)
+	{
+		cpu_relax();
+		if (m->state == 0 && cmpxchg(&m->state, 0, 1) == 0)
+			return;
+	}
+
+	//then block: mark it contended so that the owner wakes us up on unlock
+	uint32 c = xchg(&m->state, 2);
+	while (c != 0)
+	{
+		sys_futex_wait(&m->state, 2);
+		c = xchg(&m->state, 2);
+	}
+}
+
+void umutex_unlock(struct umutex *m)
+{
+	if (xchg(&m->state, 0) == 2)
+		sys_futex_wake(&m->state, 1);
+}
+
+//===============================
+// CONDITION VARIABLE:
+//===============================
+void ucond_init(struct ucond *cv)
+{
+	cv->seq = 0;
+	cv->waiters = 0;
+}
+
+void ucond_wait(struct ucond *cv, struct umutex *m)
+{
+	xadd(&cv->waiters, 1);
+	uint32 seq = cv->seq;
+	umutex_unlock(m);
+
+	//returns at once if signaled since reading seq
+	sys_futex_wait(&cv->seq, seq);
+
+	xadd(&cv->waiters, -1);
+	//others may be woken with us: take it as contended
+	while (xchg(&m->state, 2) != 0)
+		sys_futex_wait(&m->state, 2);
+}
+
+void ucond_signal(struct ucond *cv)
+{
+	xadd(&cv->seq, 1);
+	if (cv->waiters > 0)
+		sys_futex_wake(&cv->seq, 1);
+}
+
+void ucond_broadcast(struct ucond *cv)
+{
+	xadd(&cv->seq, 1);
+	if (cv->waiters > 0)
+		sys_futex_wake(&cv->seq, NENV);
+}
@@ -0,0 +1,36 @@
+// 2026: User-level message passing (see sys_ipc_send / sys_ipc_recv)
+
+#include "inc/lib.h"
+
+//Send value (& move the npages at srcva, if not NULL) to the env envID,
+//blocking till it receives
+//Returns the # pages moved (the sender keeps them allocated, their content is
+//gone), or
+//panics on error
+int ipc_send(int32 envID, uint32 value, void *srcva, uint32 npages)
+{
+	if (srcva == NULL)
+		npages = 0;
+	int ret = sys_ipc_send(envID, value, srcva, npages);
+	if (ret < 0)
+		panic("ipc_send: failed to send to env %d (error %d)", envID, ret);
+	return ret;
+}
+
+//Receive a message & return its value. If dstva is not NULL, its pages (at
+//most maxpages) are mapped at dstva, in place of the ones there
+//If from_env/npages are not NULL, they're set to the sender & the # pages
+//received
+uint32 ipc_recv(int32 *from_env, void *dstva, uint32 maxpages, uint32 *npages)
+{
+	if (dstva == NULL)
+		maxpages = 0;
+	int ret = sys_ipc_recv(dstva, maxpages);
+	if (ret < 0)
+		panic("ipc_recv: failed to receive (error %d)", ret);
+	if (from_env != NULL)
+		*from_env = myEnv->ipc_from;
+	if (npages != NULL)
+		*npages = myEnv->ipc_npages;
+	return myEnv->ipc_value;
+}
@@ -0,0 +1,192 @@
+// 2026: lock-free SPSC & MPMC ring buffers in shared memory
+// Ref: D. Vyukov, "Bounded MPMC queue" (1024cores.net)
+
+#include "inc/lib.h"
+
+//x86 doesn't reorder a load with older loads, or a store with older
+//accesses: keeping the compiler from reordering them is enough, except
+//where a store must be visible before a later load (see ring_publish)
+#define compiler_barrier()	__asm __volatile("" ::: "memory")
+
+static inline uint8* ring_slot(struct ring *r, uint32 pos)
+{
+	return &r->slots[(pos & r->mask) * r->slot_size];
+}
+
+//Make a new head/tail/slot sequence # visible, then wake up one env waiting
+//for it (if any).
+//The store is an xchg: a locked instruction is a full barrier, so the waiter
+//either sees the new value when it rechecks the ring, or is seen here as a
+//waiter.
+static inline void ring_publish(volatile uint32 *addr, uint32 val, uint32 *seq, volatile uint32 *waiters)
+{
+	xchg(addr, val);
+	if (*waiters > 0)
+	{
+		xadd(seq, 1);
+		sys_futex_wake(seq, 1);
+	}
+}
+
+//===============================
+// CREATE / OPEN:
+//===============================
+struct ring* ring_create(char *name, uint32 nslots, uint32 elem_size, int type)
+{
+	if (nslots == 0 || elem_size == 0 || (type != RING_SPSC && type != RING_MPMC))
+		return NULL;
+
+	uint32 size = 1;
+	while (size < nslots)
+		size <<= 1;
+	uint32 slot_size = ROUNDUP(elem_size, 4);
+	if (type == RING_MPMC)
+		slot_size += sizeof(uint32);
+
+	struct ring *r = smalloc(name, sizeof(struct ring) + size * slot_size, 1);
+	if (r == NULL)
+		return NULL;
+	memset(r, 0, sizeof(struct ring));
+	r->type = type;
+	r->size = size;
+	r->mask = size - 1;
+	r->elem_size = elem_size;
+	r->slot_size = slot_size;
+
+	//MPMC: slot i is free for the producer at position i
+	if (type == RING_MPMC)
+		for (uint32 i = 0; i < size; i++)
+			*(uint32*)ring_slot(r, i) = i;
+	return r;
+}
+
+struct ring* ring_open(int32 ownerEnvID, char *name)
+{
+	return sget(ownerEnvID, name);
+}
+
+//===============================
+// NON-BLOCKING:
+//===============================
+//Return 1 if the message is sent/received, 0 if the ring is full/empty
+int ring_trysend(struct ring *r, const void *msg)
+{
+	if (r->type == RING_SPSC)
+	{
+		uint32 tail = r->tail;
+		if (tail - r->head == r->size)
+			return 0;
+		memcpy(ring_slot(r, tail), msg, r->elem_size);
+		ring_publish(&r->tail, tail + 1, &r->not_empty, &r->empty_waiters);
+		return 1;
+	}
+
+	uint32 pos = r->tail;
+	volatile uint32 *seq;
+	while (1)
+	{
+		seq = (volatile uint32*)ring_slot(r, pos);
+		int32 dif = (int32)(*seq - pos);
+		if (dif == 0)
+		{
+			if (cmpxchg(&r->tail, pos, pos + 1) == pos)
+				break;
+		}
+		else if (dif < 0)
+			return 0;		//the slot wasn't read yet a round ago: full
+		pos = r->tail;
+	}
+	memcpy((void*)(seq + 1), msg, r->elem_size);
+	ring_publish(seq, pos + 1, &r->not_empty, &r->empty_waiters);
+	return 1;
+}
+
+int ring_tryrecv(struct ring *r, void *msg)
+{
+	if (r->type == RING_SPSC)
+	{
+		uint32 head = r->head;
+		if (r->tail == head)
+			return 0;
+		compiler_barrier();
+		memcpy(msg, ring_slot(r, head), r->elem_size);
+		ring_publish(&r->head, head + 1, &r->not_full, &r->full_waiters);
+		return 1;
+	}
+
+	uint32 pos = r->head;
+	volatile uint32 *seq;
+	while (1)
+	{
+		seq = (volatile uint32*)ring_slot(r, pos);
+		int32 dif = (int32)(*seq - (pos + 1));
+		if (dif == 0)
+		{
+			if (cmpxchg(&r->head, pos, pos + 1) == pos)
+				break;
+		}
+		else if (dif < 0)
+			return 0;		//the slot wasn't written yet: empty
+		pos = r->head;
+	}
+	compiler_barrier();
+	memcpy(msg, (void*)(seq + 1), r->elem_size);
+	//free for the producer a round later
+	ring_publish(seq, pos + r->size, &r->not_full, &r->full_waiters);
+	return 1;
+}
+
+//===============================
+// BLOCKING:
+//===============================
+static inline int ring_try(struct ring *r, void *msg, int send)
+{
+	return send ? ring_trysend(r, msg) : ring_tryrecv(r, msg);
+}
+
+//Send/receive, sleeping on a futex while the ring is full/empty
+static void ring_wait(struct ring *r, void *msg, int send)
+{
+	//spin for a while: an env on another CPU may make progress soon
+	for (int i = 0; i < FUTEX_SPIN_COUNT; i++)
+	{
+		if (ring_try(r, msg, send))
+			return;
+		cpu_relax();
+	}
+
+	uint32 *seq = send ? &r->not_full : &r->not_empty;
+	uint32 *waiters = send ? &r->full_waiters : &r->empty_waiters;
+	while (1)
+	{
+		//register as a waiter, then recheck: the other side either sees us
+		//or changes seq before we sleep on it
+		uint32 s = *(volatile uint32*)seq;
+		xadd(waiters, 1);
+		int ok = ring_try(r, msg, send);
+		if (!ok)
+		{
+			xadd(send ? &r->send_blocks : &r->recv_blocks, 1);
+			sys_futex_wait(seq, s);
+		}
+		xadd(waiters, -1);
+		if (ok)
+			return;
+	}
+}
+
+void ring_send(struct ring *r, const void *msg)
+{
+	ring_wait(r, (void*)msg, 1);
+}
+
+void ring_recv(struct ring *r, void *msg)
+{
+	ring_wait(r, msg, 0);
+}
+
+//# messages in the ring (approximate while others are sending/receiving)
+uint32 ring_count(struct ring *r)
+{
+	return r->tail - r->head;
+}
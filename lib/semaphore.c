@@ -44,38 +44,57 @@ struct semaphore get_semaphore(int32 ownerEnvID, char* semaphoreName)
 	return sem;
 }
 
+//2026: the count is updated atomically (no system call unless it must block
+//or wakeup). Each signal of a -ve count posts a wakeup that exactly one
+//waiter consumes: it spins for a while for it, then sleeps on the futex.
 void wait_semaphore(struct semaphore sem)
 {
 	//TODO: [PROJECT'24.MS3 - #04] [2] USER-LEVEL SEMAPHORE - wait_semaphore
-	
-	uint32 keyw = 1;
-	
-	while(xchg(&(sem.semdata->lock), keyw) != 0);
-
-	sem.semdata->count--;
-	
-	if (sem.semdata->count < 0){
-		block_and_schedule_next(sem.semdata);
+	volatile uint32 *count = (volatile uint32 *)&sem.semdata->count;
+	volatile uint32 *wakeups = &sem.semdata->wakeups;
+
+	//spin for a while on an available count
+	for (int i = 0; i < FUTEX_SPIN_COUNT; i++)
+	{
+		int c = (int)*count;
+		if (c > 0 && cmpxchg(count, c, c - 1) == c)
+			return;
+		if (c < 0)
+			break;		//others are already waiting: queue behind them
+		cpu_relax();
+	}
+
+	int old = (int)xadd(count, -1);
+	if (old > 0)
+		return;
+
+	//consume a wakeup
+	int spins = 0;
+	for (;;)
+	{
+		uint32 w = *wakeups;
+		if (w > 0)
+		{
+			if (cmpxchg(wakeups, w, w - 1) == w)
+				return;
+			continue;
+		}
+		if (spins++ < FUTEX_SPIN_COUNT)
+			cpu_relax();
+		else
+			sys_futex_wait((uint32 *)wakeups, 0);
 	}
-	
-	sem.semdata->lock = 0;
 }
 
 void signal_semaphore(struct semaphore sem)
 {
 	//TODO: [PROJECT'24.MS3 - #05] [2] USER-LEVEL SEMAPHORE - signal_semaphore
+	int old = (int)xadd((volatile uint32 *)&sem.semdata->count, 1);
+	if (old >= 0)
+		return;
 
-	uint32 keys = 1;
-
-	while(xchg(&(sem.semdata->lock), keys) != 0);
-	
-	sem.semdata->count++;
-	
-	if (sem.semdata->count <= 0) {
-		unblock_and_enqueue_ready(sem.semdata);
-	}
-
-	sem.semdata->lock = 0;
+	xadd(&sem.semdata->wakeups, 1);
+	sys_futex_wake(&sem.semdata->wakeups, 1);
 }
 
 int semaphore_count(struct semaphore sem)
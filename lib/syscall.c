@@ -145,6 +145,16 @@ int sys_create_env(char* programName, unsigned int page_WS_size,unsigned int LRU
 	return syscall(SYS_create_env,(uint32)programName, (uint32)page_WS_size,(uint32)LRU_second_list_size, (uint32)percent_WS_pages_to_remove, 0);
 }
 
+int sys_env_fork(void)
+{
+	return syscall(SYS_env_fork, 0, 0, 0, 0, 0);
+}
+
+int sys_env_set_tickets(int32 envID, uint32 tickets)
+{
+	return syscall(SYS_env_set_tickets, (uint32)envID, tickets, 0, 0, 0);
+}
+
 void sys_run_env(int32 envId)
 {
 	syscall(SYS_run_env, (int32)envId, 0, 0, 0, 0);
@@ -186,10 +196,9 @@ struct uint64 sys_get_virtual_time()
 }
 
 // 2014
-void sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size)
+int sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size)
 {
-	syscall(SYS_move_user_mem, src_virtual_address, dst_virtual_address, size, 0, 0);
-	return ;
+	return syscall(SYS_move_user_mem, src_virtual_address, dst_virtual_address, size, 0, 0);
 }
 uint32 sys_rcr2()
 {
@@ -320,6 +329,36 @@ void sys_allocate_user_mem(uint32 virtual_address, uint32 size)
 	syscall(SYS_allocate_user_mem, virtual_address, size, 0, 0, 0);
 }
 
+//2026: block (without using the CPU) for about the given # milliseconds
+void sys_sleep_ms(uint32 milliseconds)
+{
+	syscall(SYS_sleep_ms, milliseconds, 0, 0, 0, 0);
+}
+
+//2026: block on the futex at uaddr if it still holds val
+int sys_futex_wait(uint32 *uaddr, uint32 val)
+{
+	return syscall(SYS_futex_wait, (uint32)uaddr, val, 0, 0, 0);
+}
+
+//2026: wakeup at most count envs blocked on the futex at uaddr
+int sys_futex_wake(uint32 *uaddr, int count)
+{
+	return syscall(SYS_futex_wake, (uint32)uaddr, (uint32)count, 0, 0, 0);
+}
+
+//2026: send value & move the npages at srcva to the env envID (blocks till it receives)
+int sys_ipc_send(int32 envID, uint32 value, void *srcva, uint32 npages)
+{
+	return syscall(SYS_ipc_send, (uint32)envID, value, (uint32)srcva, npages, 0);
+}
+
+//2026: block till a message is received (its pages, at most maxpages, replace the ones at dstva)
+int sys_ipc_recv(void *dstva, uint32 maxpages)
+{
+	return syscall(SYS_ipc_recv, (uint32)dstva, maxpages, 0, 0, 0);
+}
+
 void block_and_schedule_next(struct __semdata *semdata)
 {
 	syscall(SYS_PROCESS_BLOCKED_SCHED, (uint32)semdata, 0, 0, 0, 0);
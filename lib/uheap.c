@@ -19,6 +19,7 @@ static bool is_uheap_initialized = 0;
 static void initialize_uheap_data_structures();
 
 static struct UheapPageInfo* to_heap_block(uint32 va);
+static struct UheapPageInfo* alloc_heap_block(uint32 required_pages);
 static struct UheapPageInfo* split_heap_block(struct UheapPageInfo* blk, uint32 required_pages);
 static void insert_heap_block_sorted(struct UheapPageInfo* b);
 static void coalescing_heap_block(struct UheapPageInfo* b);
@@ -76,22 +77,12 @@ void* malloc(uint32 size)
 
 	// Page Allocator will be used
 	uint32 required_pages = ROUNDUP(size , PAGE_SIZE) / PAGE_SIZE;
-	struct UheapPageInfo* blk = NULL;
-
-	LIST_FOREACH(blk, &free_uheap_blocks_list) {
-		if (blk->page_count >= required_pages) { break; }
-	}
+	struct UheapPageInfo* blk = alloc_heap_block(required_pages);
 
 	if (!blk) {
 		return NULL;
 	}
 
-	struct UheapPageInfo* new_blk = split_heap_block(blk , required_pages);
-	if (new_blk) {
-		LIST_INSERT_AFTER(&free_uheap_blocks_list, blk, new_blk);
-	}
-	LIST_REMOVE(&free_uheap_blocks_list, blk);
-
 	sys_allocate_user_mem(blk->start_va, size);
 	return (void *) blk->start_va;
 }
@@ -260,13 +251,99 @@ void sfree(void* virtual_address)
 //		which switches to the kernel mode, calls move_user_mem(...)
 //		in "kern/mem/chunk_operations.c", then switch back to the user mode here
 //	the move_user_mem() function is empty, make sure to implement it.
+static void *realloc_by_copy(void *virtual_address, uint32 old_size, uint32 new_size)
+{
+	void *new_va = malloc(new_size);
+	if (!new_va) {
+		return NULL;
+	}
+	memcpy(new_va, virtual_address, MIN(old_size, new_size));
+	free(virtual_address);
+	return new_va;
+}
+
+//2026: page allocations are resized in place when possible, and otherwise
+//moved by remapping their pages (sys_move_user_mem): no data is copied, so
+//growing a large array costs O(pages) PTE updates
 void *realloc(void *virtual_address, uint32 new_size)
 {
-	//[PROJECT]
-	// Write your code here, remove the panic and write your code
-	panic("realloc() is not implemented yet...!!");
-	return NULL;
+	if (!virtual_address) {
+		return malloc(new_size);
+	}
+	if (new_size == 0) {
+		free(virtual_address);
+		return NULL;
+	}
+
+	if (!is_uheap_initialized) {
+		initialize_uheap_data_structures();
+	}
+
+	// Block Allocator
+	if ((uint32)virtual_address < myEnv->uheap_limit) {
+		if (new_size <= DYN_ALLOC_MAX_BLOCK_SIZE) {
+			return realloc_block_FF(virtual_address, new_size);
+		}
+		return realloc_by_copy(virtual_address, get_block_size(virtual_address) - 2 * sizeof(uint32), new_size);
+	}
+
+	// Page Allocator
+	struct UheapPageInfo* blk = to_heap_block(ROUNDDOWN((uint32)virtual_address, PAGE_SIZE));
+	uint32 old_pages = blk->page_count;
+	uint32 new_pages = ROUNDUP(new_size, PAGE_SIZE) / PAGE_SIZE;
+
+	if (new_size <= DYN_ALLOC_MAX_BLOCK_SIZE) {
+		return realloc_by_copy(virtual_address, old_pages * PAGE_SIZE, new_size);
+	}
+	if (new_pages == old_pages) {
+		return virtual_address;
+	}
+
+	// shrink: free its last pages
+	if (new_pages < old_pages) {
+		struct UheapPageInfo* tail = split_heap_block(blk, new_pages);
+		uint32 tail_va = tail->start_va;
+		insert_heap_block_sorted(tail);
+		coalescing_heap_block(tail);
+		sys_free_user_mem(tail_va, (old_pages - new_pages) * PAGE_SIZE);
+		return virtual_address;
+	}
+
+	// grow in place if the pages right after it are free
+	uint32 extra_pages = new_pages - old_pages;
+	uint32 end_va = blk->start_va + old_pages * PAGE_SIZE;
+	struct UheapPageInfo* next = NULL;
+	LIST_FOREACH(next, &free_uheap_blocks_list) {
+		if (next->start_va >= end_va) { break; }
+	}
+	if (next && next->start_va == end_va && next->page_count >= extra_pages) {
+		struct UheapPageInfo* rest = split_heap_block(next, extra_pages);
+		if (rest) {
+			LIST_INSERT_AFTER(&free_uheap_blocks_list, next, rest);
+		}
+		LIST_REMOVE(&free_uheap_blocks_list, next);
+		blk->page_count = new_pages;
+		sys_allocate_user_mem(end_va, extra_pages * PAGE_SIZE);
+		return virtual_address;
+	}
 
+	// otherwise, move its pages to a new place
+	struct UheapPageInfo* new_blk = alloc_heap_block(new_pages);
+	if (!new_blk) {
+		return NULL;
+	}
+	if (sys_move_user_mem(blk->start_va, new_blk->start_va, old_pages * PAGE_SIZE) != 0) {
+		insert_heap_block_sorted(new_blk);
+		coalescing_heap_block(new_blk);
+		return NULL;
+	}
+	sys_allocate_user_mem(new_blk->start_va + old_pages * PAGE_SIZE, extra_pages * PAGE_SIZE);
+
+	// the kernel already left the old pages free
+	uint32 offset = (uint32)virtual_address - blk->start_va;
+	insert_heap_block_sorted(blk);
+	coalescing_heap_block(blk);
+	return (void *)(new_blk->start_va + offset);
 }
 
 
@@ -297,6 +374,28 @@ to_heap_block(uint32 va) {
 	return uheap_pages_info + offset;
 }
 
+//First fit: take required_pages pages from the free list
+static struct UheapPageInfo*
+alloc_heap_block(uint32 required_pages)
+{
+	struct UheapPageInfo* blk = NULL;
+
+	LIST_FOREACH(blk, &free_uheap_blocks_list) {
+		if (blk->page_count >= required_pages) { break; }
+	}
+
+	if (!blk) {
+		return NULL;
+	}
+
+	struct UheapPageInfo* new_blk = split_heap_block(blk , required_pages);
+	if (new_blk) {
+		LIST_INSERT_AFTER(&free_uheap_blocks_list, blk, new_blk);
+	}
+	LIST_REMOVE(&free_uheap_blocks_list, blk);
+	return blk;
+}
+
 static struct UheapPageInfo*
 split_heap_block(struct UheapPageInfo* blk, uint32 required_pages)
 {
@@ -0,0 +1,86 @@
+// 2026: Test fork (copy-on-write): the child sees the pages of the parent as
+// they were at the fork, the writes of each side are not seen by the other,
+// and a page is copied (i.e. takes a frame) only at the first write to it
+// while it's still shared
+#include <inc/lib.h>
+
+#define NUM_OF_PAGES	8
+#define WORDS_PER_PAGE	(PAGE_SIZE / sizeof(uint32))
+
+static void fill(uint32 *buf, uint32 value)
+{
+	for (int p = 0; p < NUM_OF_PAGES; p++)
+		buf[p * WORDS_PER_PAGE] = value + p;
+}
+
+static void check(uint32 *buf, uint32 value, char *who)
+{
+	for (int p = 0; p < NUM_OF_PAGES; p++)
+	{
+		if (buf[p * WORDS_PER_PAGE] != value + p)
+			panic("Error: %s sees %d in page %d instead of %d", who, buf[p * WORDS_PER_PAGE], p, value + p);
+	}
+}
+
+void
+_main(void)
+{
+	uint32 *written = malloc(NUM_OF_PAGES * PAGE_SIZE);	//written by both after the fork
+	uint32 *child_only = malloc(NUM_OF_PAGES * PAGE_SIZE);	//written by the child only
+	uint32 *warmup = malloc(PAGE_SIZE);
+	struct semaphore done = create_semaphore("done", 0);
+	if (written == NULL || child_only == NULL || warmup == NULL || done.semdata == NULL)
+		panic("Error: allocation failed");
+	fill(written, 100);
+	fill(child_only, 200);
+	*warmup = 1;
+
+	int id = sys_env_fork();
+	if (id < 0)
+		panic("Error: fork failed (ret = %d)", id);
+	if (id == 0)
+	{
+		//the parent wrote & copied these pages before the child runs: the
+		//child holds the only reference to the originals, no copy is needed
+		check(written, 100, "child");
+		uint32 freeFrames = sys_calculate_free_frames();
+		fill(written, 300);
+		if (freeFrames != sys_calculate_free_frames())
+			panic("Error: the child took %d frames to write its own pages", freeFrames - sys_calculate_free_frames());
+
+		//these pages are still shared: one copy each
+		check(child_only, 200, "child");
+		freeFrames = sys_calculate_free_frames();
+		fill(child_only, 400);
+		if (freeFrames - sys_calculate_free_frames() != NUM_OF_PAGES)
+			panic("Error: the child took %d frames to write %d shared pages", freeFrames - sys_calculate_free_frames(), NUM_OF_PAGES);
+		check(written, 300, "child");
+		check(child_only, 400, "child");
+
+		signal_semaphore(done);
+		return;
+	}
+
+	//the 1st copy may need a page table (e.g. for the temp page used to copy)
+	*warmup = 2;
+
+	//reading a shared page takes no frame, writing it takes one
+	uint32 freeFrames = sys_calculate_free_frames();
+	check(written, 100, "parent");
+	check(child_only, 200, "parent");
+	if (freeFrames != sys_calculate_free_frames())
+		panic("Error: reading the shared pages took %d frames", freeFrames - sys_calculate_free_frames());
+	fill(written, 500);
+	if (freeFrames - sys_calculate_free_frames() != NUM_OF_PAGES)
+		panic("Error: the parent took %d frames to write %d shared pages", freeFrames - sys_calculate_free_frames(), NUM_OF_PAGES);
+
+	sys_run_env(id);
+	wait_semaphore(done);
+
+	//the writes of the child are not seen here
+	check(written, 500, "parent");
+	check(child_only, 200, "parent");
+
+	cprintf("Congratulations!! Test of fork (copy-on-write) completed successfully!!\n\n\n");
+	return;
+}
@@ -0,0 +1,49 @@
+// 2026: Test the futex mutex & condition variable
+// Master program: create the shared data, run slaves that increment a counter
+// in a critical section, and wait on the condition variable till they finish
+#include <inc/lib.h>
+
+#define NUM_SLAVES	4
+#define NUM_INCS	1000
+
+struct futex_shared
+{
+	struct umutex mtx;
+	struct ucond done_cv;
+	int counter;
+	int finished;
+};
+
+void
+_main(void)
+{
+	struct futex_shared *sh = smalloc("futexShared", sizeof(struct futex_shared), 1);
+	if (sh == NULL)
+		panic("Error: failed to create the shared data");
+	umutex_init(&sh->mtx);
+	ucond_init(&sh->done_cv);
+	sh->counter = 0;
+	sh->finished = 0;
+
+	for (int i = 0; i < NUM_SLAVES; i++)
+	{
+		int id = sys_create_env("futexSlave", (myEnv->page_WS_max_size), (myEnv->SecondListSize), (myEnv->percentage_of_WS_pages_to_be_removed));
+		if (id == E_ENV_CREATION_ERROR)
+			panic("Error: failed to create the slaves");
+		sys_run_env(id);
+	}
+
+	umutex_lock(&sh->mtx);
+	while (sh->finished < NUM_SLAVES)
+		ucond_wait(&sh->done_cv, &sh->mtx);
+	int counter = sh->counter;
+	umutex_unlock(&sh->mtx);
+
+	if (counter != NUM_SLAVES * NUM_INCS)
+		panic("Error: wrong counter value... please review your futex code again! Expected = %d, Actual = %d", NUM_SLAVES * NUM_INCS, counter);
+	if (sh->mtx.state != 0)
+		panic("Error: the mutex is still locked (state = %d)", sh->mtx.state);
+
+	cprintf("Congratulations!! Test of Futexes completed successfully!!\n\n\n");
+	return;
+}
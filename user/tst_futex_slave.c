@@ -0,0 +1,41 @@
+// 2026: Test the futex mutex & condition variable
+// Slave program: increment the shared counter in a critical section, then
+// signal the master program
+#include <inc/lib.h>
+
+#define NUM_INCS	1000
+
+struct futex_shared
+{
+	struct umutex mtx;
+	struct ucond done_cv;
+	int counter;
+	int finished;
+};
+
+void
+_main(void)
+{
+	int32 parentenvID = sys_getparentenvid();
+	struct futex_shared *sh = sget(parentenvID, "futexShared");
+	if (sh == NULL)
+		panic("Error: failed to get the shared data");
+
+	for (int i = 0; i < NUM_INCS; i++)
+	{
+		umutex_lock(&sh->mtx);
+		{
+			int c = sh->counter;
+			if (i % 100 == 0)
+				env_sleep(1);	//get preempted inside the CS sometimes
+			sh->counter = c + 1;
+		}
+		umutex_unlock(&sh->mtx);
+	}
+
+	umutex_lock(&sh->mtx);
+	sh->finished++;
+	ucond_signal(&sh->done_cv);
+	umutex_unlock(&sh->mtx);
+	return;
+}
@@ -0,0 +1,60 @@
+// 2026: Test the message passing (sys_ipc_send / sys_ipc_recv)
+// Master program: receive a value-only message, then buffers whose pages move
+// from the slave (a small one, then one larger than the WS: it's partly in
+// the page file on both sides, then the same one refilled), checking their
+// content
+#include <inc/lib.h>
+
+#define SMALL_PAGES		4
+#define LARGE_PAGES		300
+#define PING_VALUE		1234
+
+#define WORDS_PER_PAGE	(PAGE_SIZE / sizeof(uint32))
+
+static void recv_buffer(int32 slaveID, uint32 npages, uint32 seed)
+{
+	uint32 *buf = malloc(npages * PAGE_SIZE);
+	if (buf == NULL)
+		panic("Error: failed to allocate the receive buffer");
+	buf[0] = 0xDEADBEEF;	//replaced by the received page
+
+	int32 from;
+	uint32 n;
+	uint64 start = read_tsc();
+	uint32 value = ipc_recv(&from, buf, npages, &n);
+	uint64 cycles = read_tsc() - start;
+	if (from != slaveID || value != seed || n != npages)
+		panic("Error: wrong message... from = %d, value = %d, # pages = %d", from, value, n);
+
+	for (uint32 p = 0; p < npages; p++)
+	{
+		if (buf[p * WORDS_PER_PAGE] != p + seed || buf[(p + 1) * WORDS_PER_PAGE - 1] != ~(p + seed))
+			panic("Error: wrong content of received page %d", p);
+	}
+	cprintf("received %d pages in %llu cycles\n", npages, cycles);
+	free(buf);
+}
+
+void
+_main(void)
+{
+	int32 slaveID = sys_create_env("ipcSlave", (myEnv->page_WS_max_size), (myEnv->SecondListSize), (myEnv->percentage_of_WS_pages_to_be_removed));
+	if (slaveID == E_ENV_CREATION_ERROR)
+		panic("Error: failed to create the slave");
+	sys_run_env(slaveID);
+
+	//[1] value only
+	int32 from;
+	uint32 n;
+	uint32 value = ipc_recv(&from, NULL, 0, &n);
+	if (from != slaveID || value != PING_VALUE || n != 0)
+		panic("Error: wrong message... from = %d, value = %d, # pages = %d", from, value, n);
+
+	//[2] pages
+	recv_buffer(slaveID, SMALL_PAGES, 0);
+	recv_buffer(slaveID, LARGE_PAGES, 0);
+	recv_buffer(slaveID, LARGE_PAGES, 1000);
+
+	cprintf("Congratulations!! Test of IPC completed successfully!!\n\n\n");
+	return;
+}
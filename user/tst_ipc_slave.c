@@ -0,0 +1,40 @@
+// 2026: Test the message passing (sys_ipc_send / sys_ipc_recv)
+// Slave program: send a value-only message, then move buffers to the master
+// program, refilling the same buffer after its pages moved
+#include <inc/lib.h>
+
+#define SMALL_PAGES		4
+#define LARGE_PAGES		300
+#define PING_VALUE		1234
+
+#define WORDS_PER_PAGE	(PAGE_SIZE / sizeof(uint32))
+
+static void send_buffer(int32 parentID, uint32 *buf, uint32 npages, uint32 seed)
+{
+	for (uint32 p = 0; p < npages; p++)
+	{
+		buf[p * WORDS_PER_PAGE] = p + seed;
+		buf[(p + 1) * WORDS_PER_PAGE - 1] = ~(p + seed);
+	}
+	if (ipc_send(parentID, seed, buf, npages) != npages)
+		panic("Error: not all the pages are sent");
+}
+
+void
+_main(void)
+{
+	int32 parentID = sys_getparentenvid();
+	uint32 *buf = malloc(LARGE_PAGES * PAGE_SIZE);
+	if (buf == NULL)
+		panic("Error: failed to allocate the send buffer");
+
+	ipc_send(parentID, PING_VALUE, NULL, 0);
+
+	send_buffer(parentID, buf, SMALL_PAGES, 0);
+	send_buffer(parentID, buf, LARGE_PAGES, 0);
+	//its pages moved, but it's still allocated: reuse it
+	send_buffer(parentID, buf, LARGE_PAGES, 1000);
+
+	free(buf);
+	return;
+}
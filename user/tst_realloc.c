@@ -0,0 +1,91 @@
+// 2026: Test realloc() of page allocations: shrinking & growing in place, and
+// moving by remapping the pages (sys_move_user_mem) without copying them
+#include <inc/lib.h>
+
+#define OLD_PAGES		64
+#define NEW_PAGES		128
+#define MORE_PAGES		192
+#define LESS_PAGES		32
+
+#define WORDS_PER_PAGE	(PAGE_SIZE / sizeof(uint32))
+
+static void fill(uint32 *buf, uint32 from, uint32 to)
+{
+	for (uint32 p = from; p < to; p++)
+	{
+		buf[p * WORDS_PER_PAGE] = p;
+		buf[(p + 1) * WORDS_PER_PAGE - 1] = ~p;
+	}
+}
+
+static void check(uint32 *buf, uint32 npages, char *when)
+{
+	for (uint32 p = 0; p < npages; p++)
+	{
+		if (buf[p * WORDS_PER_PAGE] != p || buf[(p + 1) * WORDS_PER_PAGE - 1] != ~p)
+			panic("Error: wrong content of page %d after %s", p, when);
+	}
+}
+
+void
+_main(void)
+{
+	uint32 *buf = malloc(OLD_PAGES * PAGE_SIZE);
+	uint32 *blocker = malloc(PAGE_SIZE);	//right after buf: it can't grow in place
+	if (buf == NULL || blocker == NULL)
+		panic("Error: malloc failed");
+	fill(buf, 0, OLD_PAGES);
+	*blocker = 1;
+
+	//[1] move: its pages are remapped
+	uint32 freeFrames = sys_calculate_free_frames();
+	uint32 pfPages = sys_pf_calculate_allocated_pages();
+	uint64 start = read_tsc();
+	uint32 *moved = realloc(buf, NEW_PAGES * PAGE_SIZE);
+	uint64 cycles = read_tsc() - start;
+	if (moved == NULL || moved == buf)
+		panic("Error: realloc didn't move the allocation");
+	if (sys_pf_calculate_allocated_pages() != pfPages)
+		panic("Error: moving the pages changed the page file");
+	//only new page tables (if any) may be allocated: a copy takes a frame per page
+	if (freeFrames - sys_calculate_free_frames() > 2)
+		panic("Error: moving the pages took %d frames", freeFrames - sys_calculate_free_frames());
+	check(moved, OLD_PAGES, "moving");
+	fill(moved, OLD_PAGES, NEW_PAGES);
+	cprintf("moved %d pages in %llu cycles\n", OLD_PAGES, cycles);
+
+	//[2] grow in place: the pages after it are free
+	uint32 *grown = realloc(moved, MORE_PAGES * PAGE_SIZE);
+	if (grown != moved)
+		panic("Error: realloc didn't grow the allocation in place");
+	check(grown, NEW_PAGES, "growing");
+	fill(grown, NEW_PAGES, MORE_PAGES);
+
+	//[3] shrink in place, its last pages are freed
+	uint32 *shrunk = realloc(grown, LESS_PAGES * PAGE_SIZE);
+	if (shrunk != grown)
+		panic("Error: realloc didn't shrink the allocation in place");
+	check(shrunk, LESS_PAGES, "shrinking");
+
+	//[4] the old place of buf is free again
+	uint32 *again = malloc(OLD_PAGES * PAGE_SIZE);
+	if (again != buf)
+		panic("Error: the moved pages are not free");
+	fill(again, 0, OLD_PAGES);
+	check(again, OLD_PAGES, "reusing the old place");
+
+	//[5] to/from the block allocator: copied
+	uint32 *small = realloc(shrunk, 100);
+	if (small == NULL || small[0] != 0)
+		panic("Error: wrong content after reallocating to a small block");
+	uint32 *big = realloc(small, 4 * PAGE_SIZE);
+	if (big == NULL || big[0] != 0)
+		panic("Error: wrong content after reallocating a small block");
+
+	free(big);
+	free(again);
+	free(blocker);
+
+	cprintf("Congratulations!! Test of realloc completed successfully!!\n\n\n");
+	return;
+}
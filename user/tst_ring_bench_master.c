@@ -0,0 +1,124 @@
+// 2026: Throughput benchmark of the lock-free ring buffers (inc/ring.h)
+// Master program: consume the messages sent by the slaves through an SPSC
+// ring, an MPMC ring, then a bounded buffer guarded by semaphores, checking
+// their order & measuring the cycles taken by each
+#include <inc/lib.h>
+
+#define NUM_PRODUCERS	3
+#define NUM_MSGS		6000	//total in each run
+#define BUF_SIZE		64
+
+#define MODE_SPSC		0
+#define MODE_MPMC		1
+#define MODE_SEM		2
+
+struct ring_msg
+{
+	uint32 producer;
+	uint32 seq;
+};
+
+struct ring_bench
+{
+	int mode;
+	int msgs_per_producer;
+	uint32 next_producer;
+
+	//bounded buffer of the semaphore run
+	uint32 in, out;
+	struct ring_msg buf[BUF_SIZE];
+};
+
+static char* mode_names[] = { "SPSC ring", "MPMC ring", "semaphores" };
+
+static void run_producers(struct ring_bench *ctl, int mode, int nproducers)
+{
+	ctl->mode = mode;
+	ctl->msgs_per_producer = NUM_MSGS / nproducers;
+	ctl->next_producer = 0;
+	for (int i = 0; i < nproducers; i++)
+	{
+		int id = sys_create_env("ringSlave", (myEnv->page_WS_max_size), (myEnv->SecondListSize), (myEnv->percentage_of_WS_pages_to_be_removed));
+		if (id == E_ENV_CREATION_ERROR)
+			panic("Error: failed to create the slaves");
+		sys_run_env(id);
+	}
+}
+
+static void check_msg(struct ring_msg *m, uint32 *expected, int nproducers)
+{
+	if (m->producer >= nproducers)
+		panic("Error: message from an unknown producer %d", m->producer);
+	if (m->seq != expected[m->producer])
+		panic("Error: message out of order from producer %d... Expected = %d, Actual = %d", m->producer, expected[m->producer], m->seq);
+	expected[m->producer]++;
+}
+
+static void print_result(int mode, uint64 cycles, struct ring *r)
+{
+	cprintf("%s: %d msgs in %llu cycles (%llu cycles/msg)", mode_names[mode], NUM_MSGS, cycles, cycles / NUM_MSGS);
+	if (r != NULL)
+		cprintf(", producers slept %d times, consumer slept %d times", r->send_blocks, r->recv_blocks);
+	cprintf("\n");
+}
+
+void
+_main(void)
+{
+	struct ring_bench *ctl = smalloc("ringBench", sizeof(struct ring_bench), 1);
+	struct ring *spsc = ring_create("ringSpsc", BUF_SIZE, sizeof(struct ring_msg), RING_SPSC);
+	struct ring *mpmc = ring_create("ringMpmc", BUF_SIZE, sizeof(struct ring_msg), RING_MPMC);
+	if (ctl == NULL || spsc == NULL || mpmc == NULL)
+		panic("Error: failed to create the shared data");
+	ctl->in = ctl->out = 0;
+	struct semaphore empty = create_semaphore("bbEmpty", BUF_SIZE);
+	struct semaphore full = create_semaphore("bbFull", 0);
+	struct semaphore mutex = create_semaphore("bbMutex", 1);
+
+	struct ring_msg m;
+	uint32 expected[NUM_PRODUCERS];
+
+	//[1] SPSC ring
+	memset(expected, 0, sizeof(expected));
+	uint64 start = read_tsc();
+	run_producers(ctl, MODE_SPSC, 1);
+	for (int i = 0; i < NUM_MSGS; i++)
+	{
+		ring_recv(spsc, &m);
+		check_msg(&m, expected, 1);
+	}
+	print_result(MODE_SPSC, read_tsc() - start, spsc);
+
+	//[2] MPMC ring
+	memset(expected, 0, sizeof(expected));
+	start = read_tsc();
+	run_producers(ctl, MODE_MPMC, NUM_PRODUCERS);
+	for (int i = 0; i < NUM_MSGS; i++)
+	{
+		ring_recv(mpmc, &m);
+		check_msg(&m, expected, NUM_PRODUCERS);
+	}
+	print_result(MODE_MPMC, read_tsc() - start, mpmc);
+
+	//[3] bounded buffer guarded by semaphores
+	memset(expected, 0, sizeof(expected));
+	start = read_tsc();
+	run_producers(ctl, MODE_SEM, NUM_PRODUCERS);
+	for (int i = 0; i < NUM_MSGS; i++)
+	{
+		wait_semaphore(full);
+		wait_semaphore(mutex);
+		m = ctl->buf[ctl->out];
+		ctl->out = (ctl->out + 1) % BUF_SIZE;
+		signal_semaphore(mutex);
+		signal_semaphore(empty);
+		check_msg(&m, expected, NUM_PRODUCERS);
+	}
+	print_result(MODE_SEM, read_tsc() - start, NULL);
+
+	if (ring_count(spsc) != 0 || ring_count(mpmc) != 0)
+		panic("Error: messages are left in the rings");
+
+	cprintf("Congratulations!! Test of the ring buffers completed successfully!!\n\n\n");
+	return;
+}
@@ -0,0 +1,65 @@
+// 2026: Throughput benchmark of the lock-free ring buffers (inc/ring.h)
+// Slave program: send numbered messages to the master program through the
+// ring/buffer of the current run
+#include <inc/lib.h>
+
+#define BUF_SIZE		64
+
+#define MODE_SPSC		0
+#define MODE_MPMC		1
+#define MODE_SEM		2
+
+struct ring_msg
+{
+	uint32 producer;
+	uint32 seq;
+};
+
+struct ring_bench
+{
+	int mode;
+	int msgs_per_producer;
+	uint32 next_producer;
+
+	//bounded buffer of the semaphore run
+	uint32 in, out;
+	struct ring_msg buf[BUF_SIZE];
+};
+
+void
+_main(void)
+{
+	int32 parentenvID = sys_getparentenvid();
+	struct ring_bench *ctl = sget(parentenvID, "ringBench");
+	if (ctl == NULL)
+		panic("Error: failed to get the shared data");
+
+	int mode = ctl->mode;
+	int nmsgs = ctl->msgs_per_producer;
+	struct ring_msg m;
+	m.producer = xadd(&ctl->next_producer, 1);
+
+	if (mode == MODE_SEM)
+	{
+		struct semaphore empty = get_semaphore(parentenvID, "bbEmpty");
+		struct semaphore full = get_semaphore(parentenvID, "bbFull");
+		struct semaphore mutex = get_semaphore(parentenvID, "bbMutex");
+		for (m.seq = 0; m.seq < nmsgs; m.seq++)
+		{
+			wait_semaphore(empty);
+			wait_semaphore(mutex);
+			ctl->buf[ctl->in] = m;
+			ctl->in = (ctl->in + 1) % BUF_SIZE;
+			signal_semaphore(mutex);
+			signal_semaphore(full);
+		}
+		return;
+	}
+
+	struct ring *r = ring_open(parentenvID, mode == MODE_SPSC ? "ringSpsc" : "ringMpmc");
+	if (r == NULL)
+		panic("Error: failed to get the ring");
+	for (m.seq = 0; m.seq < nmsgs; m.seq++)
+		ring_send(r, &m);
+	return;
+}
@@ -0,0 +1,75 @@
+// 2026: Test the lookup of many shared objects by name: the cost of a lookup
+// should not grow with the # shared objects (they're hashed by owner & name)
+#include <inc/lib.h>
+
+#define NUM_OF_SHARES	256
+#define NUM_OF_LOOKUPS	16
+
+static void share_name(int i, char *name)
+{
+	char num[16];
+	ltostr(i, num);
+	strcconcat("s", num, name);
+}
+
+//Average cycles to look up the last NUM_OF_LOOKUPS shares created
+static uint64 lookup_cycles(int created)
+{
+	char name[32];
+	uint64 cycles = 0;
+	for (int i = created - NUM_OF_LOOKUPS; i < created; i++)
+	{
+		share_name(i, name);
+		uint64 start = read_tsc();
+		int size = sys_getSizeOfSharedObject(myEnv->env_id, name);
+		cycles += read_tsc() - start;
+		if (size != sizeof(uint32))
+			panic("Error: shared object %s not found (ret = %d)", name, size);
+	}
+	return cycles / NUM_OF_LOOKUPS;
+}
+
+void
+_main(void)
+{
+	char name[32];
+	uint64 cycles_few = 0;
+	uint32 *x = NULL;
+	for (int i = 0; i < NUM_OF_SHARES; i++)
+	{
+		share_name(i, name);
+		uint32 *ptr = smalloc(name, sizeof(uint32), 1);
+		if (ptr == NULL)
+			panic("Error: failed to create shared object %s", name);
+		*ptr = i;
+		if (i == 100)
+			x = ptr;
+		if (i + 1 == NUM_OF_LOOKUPS)
+			cycles_few = lookup_cycles(i + 1);
+	}
+	uint64 cycles_many = lookup_cycles(NUM_OF_SHARES);
+	cprintf("lookup: %llu cycles with %d shared objects, %llu cycles with %d\n",
+			cycles_few, NUM_OF_LOOKUPS, cycles_many, NUM_OF_SHARES);
+
+	//an existing name is refused
+	if (smalloc("s5", sizeof(uint32), 1) != NULL)
+		panic("Error: shared object s5 created twice");
+
+	//get one, then free it from both places: it's deleted
+	uint32 *y = sget(myEnv->env_id, "s100");
+	if (y == NULL || *y != 100)
+		panic("Error: wrong shared object s100");
+	*y = 1000;
+	if (*x != 1000)
+		panic("Error: s100 is not shared");
+	sfree(y);
+	if (sys_getSizeOfSharedObject(myEnv->env_id, "s100") != sizeof(uint32))
+		panic("Error: s100 deleted while still referenced");
+	sfree(x);
+	if (sys_getSizeOfSharedObject(myEnv->env_id, "s100") != E_SHARED_MEM_NOT_EXISTS)
+		panic("Error: s100 not deleted");
+
+	//the others are deleted by env_free()
+	cprintf("Congratulations!! Test of shared objects lookup completed successfully!!\n\n\n");
+	return;
+}
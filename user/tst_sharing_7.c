@@ -0,0 +1,55 @@
+// 2026: Test fork after smalloc: a shared object created by the parent (and
+// not got by anyone yet) should stay shared with the child (no copy-on-write),
+// its semaphores should block & wakeup across both, and the child should hold
+// its own reference to it
+#include <inc/lib.h>
+
+void
+_main(void)
+{
+	int32 parentId = myEnv->env_id;
+	uint32 *x = smalloc("x", 2 * PAGE_SIZE, 1);
+	if (x == NULL)
+		panic("Error: failed to create shared object x");
+	struct semaphore toChild = create_semaphore("toChild", 0);
+	struct semaphore toParent = create_semaphore("toParent", 0);
+	if (toChild.semdata == NULL || toParent.semdata == NULL)
+		panic("Error: failed to create the semaphores");
+	x[0] = 1;
+
+	int id = sys_env_fork();
+	if (id < 0)
+		panic("Error: fork failed (ret = %d)", id);
+	if (id == 0)
+	{
+		//child: sees the parent's write done after the fork, writes on both pages
+		wait_semaphore(toChild);
+		if (x[0] != 2)
+			panic("Error: the child doesn't see the write of the parent (x[0] = %d)", x[0]);
+		x[1] = 3;
+		x[PAGE_SIZE / sizeof(uint32)] = 4;
+		//its reference only is released
+		sfree(x);
+		signal_semaphore(toParent);
+		return;
+	}
+	sys_run_env(id);
+
+	x[0] = 2;
+	signal_semaphore(toChild);
+	wait_semaphore(toParent);
+	if (x[1] != 3 || x[PAGE_SIZE / sizeof(uint32)] != 4)
+		panic("Error: the parent doesn't see the writes of the child");
+
+	if (sys_getSizeOfSharedObject(parentId, "x") != 2 * PAGE_SIZE)
+		panic("Error: x deleted by the child while the parent still uses it");
+	x[0] = 5;
+	if (x[0] != 5)
+		panic("Error: x is not accessible anymore");
+	sfree(x);
+	if (sys_getSizeOfSharedObject(parentId, "x") != E_SHARED_MEM_NOT_EXISTS)
+		panic("Error: x not deleted");
+
+	cprintf("Congratulations!! Test of fork after smalloc completed successfully!!\n\n\n");
+	return;
+}
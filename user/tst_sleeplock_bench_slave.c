@@ -0,0 +1,20 @@
+// 2026: Contended sleep lock benchmark (see "tst slplk")
+// Slave program: acquire & release the test sleep lock in a loop, doing some
+// work while holding it so that it's often preempted inside the CS
+#include <inc/lib.h>
+
+#define NUM_ITERATIONS	200
+
+void
+_main(void)
+{
+	for (int i = 0; i < NUM_ITERATIONS; i++)
+	{
+		sys_utilities("__AcquireSleepLock__", 0);
+		{
+			busy_wait(20000);
+		}
+		sys_utilities("__ReleaseSleepLock__", 0);
+	}
+	return;
+}